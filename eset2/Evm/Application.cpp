@@ -8,6 +8,7 @@
 #include "ThreadContext.h"
 #include "Application.h"
 #include "RuntimeError.h"
+#include "Platform.h"
 #include "tclap/CmdLine.h"
 
 
@@ -16,7 +17,18 @@ namespace Evm {
 		_config{ config },
 		_evm{ _parseEvmFile(config) },
 		_programMemory{ _extractProgramMemory(*_evm) },
-		_dataMemory{ _evm->header.dataSize }
+		_program{ _programMemory, _evm->header.dataSize },
+		_dataMemory{ _evm->header.dataSize },
+		_cpuPlacement{ config.affinity, config.cpuSet },
+		_workerPool{ config.workerPoolSize, config.workerPoolMaxIdle, 
+			[this]() { _cpuPlacement.pinCurrentThread(); } },
+		_scheduler{ (config.scheduler == SchedulerPolicy::RoundRobin) ? 
+			make_unique<RoundRobinScheduler>(config.quantum) : nullptr },
+		_lockList{ config.lockPolicy, config.statistics },
+		_lockProfiler{ config.lockProfileFileName.empty() ? nullptr : make_unique<Utils::LockProfiler>() },
+		_fileTable{ config.manifestFileName },
+		_consoleOutput{ config.lineBufferedOutput || Platform::standardOutputIsTerminal() },
+		_consoleInput{ _consoleOutput }
 	{
 		//cout << *_evm << "\n";
 
@@ -24,83 +36,245 @@ namespace Evm {
 		auto initDataIts = File::extractInitializedData(*_evm);
 		_dataMemory.write(0, initDataIts.first, initDataIts.second);
 
-		// open input file if it is given by an user
+		// open user files if they are given by an user. With an output file the input
+		// file is only read.
+		Utils::FileOptions options;
+		options.mode = config.inputFileMode;
+		options.writeCacheSize = config.writeCacheSize;
 		if (_config.inputFileIsGiven) {
-			_inputFileStream.open(config.inputFileName, fstream::in | fstream::out | fstream::binary | fstream::app);
-			if (!_inputFileStream.is_open()) {
-				throw InputFileRuntimeError{ config.inputFileName, "Unable to open" };
-			}
+			Utils::FileOptions inputOptions;
+			inputOptions.access = Platform::FileAccess::ReadSequential;
+			_inputFile = Utils::makeFile(config.inputFileName, _config.outputFileIsGiven ? inputOptions : options);
+		}
+		if (_config.outputFileIsGiven) {
+			options.access = Platform::FileAccess::Create;
+			options.expectedSize = config.outputFileSize;
+			_outputFile = Utils::makeFile(config.outputFileName, options);
+		}
+
+		// a system thread would wait for its transfer anyway, only threads of the round-robin
+		// scheduler run while their transfers are in progress.
+		// Files of the manifest are positional, they always have native handles.
+		Platform::FileHandle handle;
+		bool nativeHandles = (!_inputFile || _inputFile->nativeHandle(handle)) &&
+			(!_outputFile || _outputFile->nativeHandle(handle));
+		if (_scheduler && (_inputFile || _outputFile || _fileTable.entries() != 0)) {
+			_asyncIo = Utils::makeAsyncIo(config.asyncIo, nativeHandles);
 		}
 	}
 
 	Application::~Application()
 	{
-		if (_config.inputFileIsGiven) {
-			_inputFileStream.close();
-		}
+		// contexts return to the pool when dropped, do it while the pool exists
+		_mainThread.reset();
+		_threadList.clear();
 	}
 
 	void Application::run()
 	{
-		//cout << "Application: spawn main thread\n";
+		_startTime = chrono::steady_clock::now();
+
 		// create first thread
-		_threadList.emplace_back(make_unique<ThreadContext>(this));
-		_threadList.at(0)->run();
-		//cout << "Application: main thread is alive!\n";
+		{
+			lock_guard<mutex> guard(_threadListGuard);
+			_mainThread = _makeThread(nullptr, 0);
+			_threadStarted();
+		}
+		_mainThread->run();
 	}
 
 	void Application::wait()
 	{
-		//cout << "Application: joining with main thread\n";
-		// wait for main thread
-		_threadList.at(0)->join();
-		//cout << "Application: main thread is over\n";
+		// wait for main thread. The round-robin scheduler executes all threads here.
+		// A deadlock is reported when the application is cleaned up.
+		bool isDeadlocked = false;
+		if (_scheduler) {
+			_cpuPlacement.pinCurrentThread();
+			try {
+				_scheduler->run(*_mainThread);
+			}
+			catch (DeadlockRuntimeError &) {
+				isDeadlocked = true;
+			}
+		}
+		else {
+			_mainThread->join();
+		}
 
 		// terminate other threads, they shouldn't run when the main thread is dead.
-		for (auto & t : _threadList) {
+		// No thread is started or disposed from now on.
+		vector<ThreadContexPtr> threads;
+		{
+			lock_guard<mutex> guard(_threadListGuard);
+			_isShuttingDown = true;
+			for (auto & t : _threadList) {
+				threads.push_back(t.second);
+			}
+		}
+		for (auto & t : threads) {
 			t->terminate();
+		}
+		// owners of the locks are terminated, waiters would never get them.
+		// joinThread waits end when the joined threads leave their loops.
+		_lockList.cancel();
+		for (auto & t : threads) {
 			t->join();
 		}
+
+		// dispose the threads that have never been run, outside of the guard - contexts lock it
+		// on the way to the pool. Finished threads are disposed by threadFinished, it must be done
+		// before the application may be destroyed.
+		ThreadList disposedThreads;
+		{
+			unique_lock<mutex> guard(_threadListGuard);
+			_threadExited.wait(guard, [this]() { return _liveThreadCount == 0; });
+			disposedThreads.swap(_threadList);
+		}
+		disposedThreads.clear();
+		threads.clear();
+		_mainThread.reset();
+
+		// all lines are buffered, the console output is complete before statistics are printed
+		_consoleOutput.flush();
+
+		// write back buffered data of user files, a failure doesn't stop the other flush
+		bool isInputFlushed = !_inputFile || _inputFile->flush();
+		bool isOutputFlushed = !_outputFile || _outputFile->flush();
+
+		_endTime = chrono::steady_clock::now();
+
+		if (isDeadlocked) {
+			throw DeadlockRuntimeError{};
+		}
+		if (!isInputFlushed) {
+			throw InputFileRuntimeError{ _inputFile->name(), "Unable to flush" };
+		}
+		if (!isOutputFlushed) {
+			throw InputFileRuntimeError{ _outputFile->name(), "Unable to flush" };
+		}
+	}
+
+	void Application::terminate()
+	{
+		vector<ThreadContexPtr> threads;
+		{
+			lock_guard<mutex> guard(_threadListGuard);
+			_isShuttingDown = true;
+			for (auto & t : _threadList) {
+				threads.push_back(t.second);
+			}
+		}
+		for (auto & t : threads) {
+			t->terminate();
+		}
+		_lockList.cancel();
 	}
 
 	uint64_t Application::runNewThread(ThreadContext & caller, uint32_t address)
 	{
 		// create new Thread from the caller
- 		_threadList.emplace_back(make_unique<ThreadContext>(caller, address));
-		uint64_t newThreadId = _threadList.size() - 1;
-		_threadList.at(newThreadId)->run();
-		return newThreadId;
+		lock_guard<mutex> guard(_threadListGuard);
+		auto newThread = _makeThread(&caller, address);
+		if (!_isShuttingDown) {
+			_threadStarted();
+			newThread->run();
+		}
+		return newThread->id();
 	}
 
-	void Application::joinThread(uint64_t threadId)
+	void Application::joinThread(ThreadContext & caller, uint64_t threadId)
 	{
-		try {
-			ThreadContext & thread = *_threadList.at(threadId);
-			thread.join();
+		ThreadContexPtr thread;
+		{
+			lock_guard<mutex> guard(_threadListGuard);
+			auto it = _threadList.find(threadId);
+			if (it == end(_threadList)) {
+				if (threadId < _nextThreadID) {
+					// IDs are never reused, a known thread that isn't listed is finished and disposed
+					return;
+				}
+				throw UnknownThreadRuntimeError(threadId);
+			}
+			thread = it->second;
 		}
-		catch (out_of_range & e) {
-			(void)e;
-			throw UnknownThreadRuntimeError(threadId);
+
+		if (_scheduler && !thread->isFinished()) {
+			caller.yield();
+			return;
 		}
+		thread->join();
 	}
 
-	void Application::lock(uint64_t lockID)
+	void Application::threadFinished(uint64_t threadId)
 	{
-		// get mutex or create new if it doesn't exist
-		mutex & m = _lockList[lockID];
-		m.lock();
+		// the context returns to the pool when the last reference is dropped,
+		// it must happen outside of the guard
+		ThreadContexPtr disposedThread;
+		{
+			lock_guard<mutex> guard(_threadListGuard);
+			auto it = _threadList.find(threadId);
+			if (it != end(_threadList)) {
+				disposedThread = move(it->second);
+				_threadList.erase(it);
+			}
+		}
+		disposedThread.reset();
+
+		// the caller must not touch the application afterwards, wait() may return
+		lock_guard<mutex> guard(_threadListGuard);
+		_liveThreadCount--;
+		_threadExited.notify_all();
 	}
 
-	void Application::unlock(uint64_t lockID)
+	void Application::lock(ThreadContext & caller, uint64_t lockID)
 	{
-		try {
-			mutex & m = _lockList.at(lockID);
-			m.unlock();
+		// get lock or create new if it doesn't exist
+		auto & m = _lockList.get(lockID);
+		if (_scheduler) {
+			// a yielded lock instruction is executed again, the wait started with its first attempt
+			auto & waitBegin = caller.lockWaitBegin();
+			bool isRetry = waitBegin != Utils::ILock::Clock::time_point{};
+			bool acquired;
+			if (_lockProfiler) {
+				acquired = isRetry ? _lockProfiler->retryLock(m, lockID, caller.instructionAddress(), waitBegin) :
+					_lockProfiler->tryLock(m, lockID, caller.instructionAddress());
+			}
+			else {
+				acquired = isRetry ? m.retryLock(waitBegin) : m.tryLock();
+			}
+			if (acquired) {
+				waitBegin = {};
+			}
+			else {
+				if (!isRetry) {
+					waitBegin = Utils::ILock::Clock::now();
+				}
+				caller.yield();
+			}
+			return;
+		}
+
+		// the result is false only for cancelled locks, the caller is terminated then
+		if (_lockProfiler) {
+			_lockProfiler->lock(m, lockID, caller.instructionAddress());
 		}
-		catch (out_of_range & e) {
-			(void)e;
+		else {
+			m.lock();
+		}
+	}
+
+	void Application::unlock(uint64_t lockID)
+	{
+		auto m = _lockList.find(lockID);
+		if (m == nullptr) {
 			throw BadLockIDRuntimeError(lockID);
 		}
+		if (_lockProfiler) {
+			_lockProfiler->unlock(*m, lockID);
+		}
+		else {
+			m->unlock();
+		}
 	}
 
 	Utils::Memory & Application::dataMemory()
@@ -113,12 +287,42 @@ namespace Evm {
 		return _programMemory;
 	}
 
-	fstream & Application::inputFile()
+	const Program & Application::program() const
 	{
-		if (!_config.inputFileIsGiven) {
+		return _program;
+	}
+
+	Utils::IFile & Application::inputFile()
+	{
+		if (!_inputFile) {
 			throw InputFileRuntimeError{ "Unknown user file. Give user file when lunch the application (-i filename)" };
 		}
-		return _inputFileStream;
+		return *_inputFile;
+	}
+
+	Utils::IFile & Application::outputFile()
+	{
+		return _outputFile ? *_outputFile : inputFile();
+	}
+
+	Utils::FileTable & Application::fileTable()
+	{
+		return _fileTable;
+	}
+
+	Utils::IAsyncIo * Application::asyncIo()
+	{
+		return _asyncIo.get();
+	}
+
+	Utils::ConsoleOutput & Application::consoleOutput()
+	{
+		return _consoleOutput;
+	}
+
+	Utils::ConsoleInput & Application::consoleInput()
+	{
+		return _consoleInput;
 	}
 
 	const string & Application::inputFileName() const
@@ -131,11 +335,125 @@ namespace Evm {
 		return _config;
 	}
 
+	Utils::WorkerPool & Application::workerPool()
+	{
+		return _workerPool;
+	}
+
+	RoundRobinScheduler * Application::scheduler()
+	{
+		return _scheduler.get();
+	}
+
+	Utils::CpuPlacement & Application::cpuPlacement()
+	{
+		return _cpuPlacement;
+	}
+
+	void Application::printStatistics(ostream & os)
+	{
+		auto runTime = chrono::duration_cast<chrono::microseconds>(_endTime - _startTime).count();
+		auto locks = _lockList.statistics();
+		const auto & waitTimes = locks.waitTimes;
+
+		os << "Execution statistics:\n";
+		os << "\trun time [ms]: " << runTime / 1000.0 << "\n";
+		os << "\tlocks (" << (_config.lockPolicy == Utils::LockPolicy::Ticket ? "ticket" : "futex") <<
+			"): acquisitions " << locks.acquisitions << ", contended " << locks.contended <<
+			", parks " << locks.parks;
+		if (runTime > 0) {
+			os << ", acquisitions/s " << static_cast<uint64_t>(locks.acquisitions * 1000000.0 / runTime);
+		}
+		os << "\n";
+		os << "\tthreads: created " << _nextThreadID << ", recycled contexts " << _recycledThreads <<
+			", peak alive " << _peakThreadCount << ", peak call depth " << _peakCallDepth << "\n";
+		auto workers = _workerPool.statistics();
+		const auto & startLatency = workers.startLatency;
+		os << "\tworkers: spawned " << workers.spawnedWorkers << ", tasks " << workers.tasks <<
+			", reused " << workers.reusedWorkers << "\n";
+		os << "\tthread start latency [ns]: p50 " << startLatency.percentile(50) << ", p99 " << 
+			startLatency.percentile(99) << ", max " << startLatency.max() << "\n";
+		_program.printStatistics(os);
+		if (_asyncIo) {
+			auto io = _asyncIo->statistics();
+			os << "\tasync io (" << _asyncIo->name() << "): requests " << io.requests << ", batches " << io.batches << "\n";
+		}
+		if (_fileTable.entries() != 0) {
+			os << "\tfile table: manifest entries " << _fileTable.entries() << ", opens " << _fileTable.opens() <<
+				", peak open " << _fileTable.peakOpen() << "\n";
+		}
+		os << "\tconsole output: lines " << _consoleOutput.lines() << ", flushes " << _consoleOutput.flushes() << "\n";
+		os << "\tconsole input: values " << _consoleInput.values() << ", reads " << _consoleInput.reads() << "\n";
+		if (_scheduler) {
+			_scheduler->printStatistics(os);
+		}
+		os << "\tcontended lock wait [ns]: p50 " << waitTimes.percentile(50) << ", p90 " << waitTimes.percentile(90) <<
+			", p99 " << waitTimes.percentile(99) << ", p99.9 " << waitTimes.percentile(99.9) <<
+			", max " << waitTimes.max() << "\n";
+		_cpuPlacement.printReport(os);
+	}
+
+	void Application::printLockProfile(ostream & os)
+	{
+		if (!_lockProfiler) {
+			return;
+		}
+
+		_lockProfiler->printTable(os);
+
+		ofstream jsonFile(_config.lockProfileFileName, ios::trunc);
+		if (!jsonFile.is_open()) {
+			throw OutputFileRuntimeError{ _config.lockProfileFileName, "Unable to open" };
+		}
+		_lockProfiler->printJson(jsonFile);
+	}
+
+	Application::ThreadContexPtr Application::_makeThread(const ThreadContext * caller, uint32_t address)
+	{
+		uint64_t id = _nextThreadID++;
+
+		unique_ptr<ThreadContext> context;
+		if (caller == nullptr) {
+			context = make_unique<ThreadContext>(this, id);
+		}
+		else if (!_contextPool.empty()) {
+			context = move(_contextPool.back());
+			_contextPool.pop_back();
+			context->reset(*caller, id, address);
+			_recycledThreads++;
+		}
+		else {
+			context = make_unique<ThreadContext>(*caller, id, address);
+		}
+
+		ThreadContexPtr res{ context.release(), [this](ThreadContext * t) { _recycleThread(t); } };
+		_threadList.emplace(id, res);
+		return res;
+	}
+
+	void Application::_threadStarted()
+	{
+		_liveThreadCount++;
+		_peakThreadCount = max(_peakThreadCount, _liveThreadCount);
+	}
+
+	void Application::_recycleThread(ThreadContext * thread)
+	{
+		unique_ptr<ThreadContext> context{ thread };
+		context->join();
+
+		lock_guard<mutex> guard(_threadListGuard);
+		_peakCallDepth = max(_peakCallDepth, context->core().callStack.peakDepth());
+		if (_contextPool.size() < MAX_POOLED_CONTEXTS) {
+			_contextPool.push_back(move(context));
+		}
+	}
+
 	unique_ptr<File::EvmFile> Application::_parseEvmFile(const CliConfiguration & config) const
 	{
 		auto evm = File::makeEvmFromFile(config.evmFileName);
 		File::validateEvm(*evm);
-		return move(evm);
+		return evm;
 	}
 
 	Utils::BitBuffer Application::_extractProgramMemory(const File::EvmFile & evm) const
@@ -149,18 +467,135 @@ namespace Evm {
 		try {
 			TCLAP::CmdLine cmd("Command description message", ' ', "0.9");
 			TCLAP::UnlabeledValueArg<string> evmFilenameArg("evm", "evm file name", true, "", "filename");
-			TCLAP::ValueArg<std::string> filenameArg("i", "input_file", "Input file", false, "in", "filename");
+			TCLAP::ValueArg<std::string> filenameArg("i", "input_file",
+				"Input file, a pipe is streamed: offsets of reads and writes must not go back", false, "in", "filename");
+			TCLAP::ValueArg<std::string> outputFilenameArg("o", "output-file",
+				"Output file, created or truncated, it takes writes and the input file is opened read only "
+				"(default writes go to the input file). A pipe is streamed, writes are appended in order", false, "", "filename");
+			TCLAP::ValueArg<uint64_t> outputSizeArg("", "output-size",
+				"Expected size of the output file, disk space is allocated in advance where the file system "
+				"supports it (default none)", false, 0, "bytes");
+			TCLAP::ValueArg<std::string> manifestArg("", "manifest",
+				"Files for evm open instruction, one path per line, the first line is file 0. "
+				"Files are opened read only, a path prefixed with '>' is opened for writing as well. "
+				"Missing files are not created. "
+				"Each opened file has its own handle, read and write use the file selected by useFile", false, "", "filename");
 			TCLAP::SwitchArg traceArg("t", "trace", "Enable execution trace");
+			TCLAP::SwitchArg mmapIoArg("", "mmap-io", 
+				"Map the input file to memory, reads and writes don't need system calls");
+			vector<string> asyncIoPolicies{ "off", "auto", "threads" };
+			TCLAP::ValuesConstraint<string> asyncIoConstraint(asyncIoPolicies);
+			TCLAP::ValueArg<string> asyncIoArg("", "async-io",
+				"Asynchronous read and write with the round-robin scheduler, only the issuing evm thread waits: "
+				"off - blocking calls (default), auto - io_uring if available, thread pool otherwise, threads - thread pool. "
+				"Evm threads on system threads always do blocking calls",
+				false, "off", &asyncIoConstraint);
+			TCLAP::ValueArg<uint64_t> writeCacheArg("", "write-cache",
+				"Buffer input file writes in a write-back cache, flushed when given amount of data is dirty (default no cache)",
+				false, 0, "KiB");
+			TCLAP::SwitchArg lineBufferedArg("", "line-buffered",
+				"Write each console output line at once (default when the output is a terminal), "
+				"otherwise lines are written in batches");
+			vector<string> lockPolicies{ "futex", "ticket" };
+			TCLAP::ValuesConstraint<string> lockPolicyConstraint(lockPolicies);
+			TCLAP::ValueArg<string> lockPolicyArg("", "lock-policy", 
+				"Implementation of evm locks: futex - spin-then-park, unfair (default), ticket - FIFO fair", 
+				false, "futex", &lockPolicyConstraint);
+			TCLAP::SwitchArg statisticsArg("s", "stats", "Print execution statistics at exit");
+			TCLAP::ValueArg<string> lockProfileArg("", "lock-profile", 
+				"Profile evm locks, print the profile at exit and write it as JSON to given file", false, "", "filename");
+			TCLAP::ValueArg<size_t> workerPoolSizeArg("", "worker-pool-size",
+				"Number of system threads spawned in advance for evm threads (default 0)", false, 0, "count");
+			TCLAP::ValueArg<size_t> workerPoolMaxIdleArg("", "worker-pool-max-idle",
+				"Number of idle system threads kept for reuse, the pool always grows when all threads are busy (default 64)", 
+				false, 64, "count");
+			vector<string> schedulers{ "os", "rr" };
+			TCLAP::ValuesConstraint<string> schedulerConstraint(schedulers);
+			TCLAP::ValueArg<string> schedulerArg("", "scheduler",
+				"Execution of evm threads: os - each thread on a system thread (default), rr - deterministic round-robin on a single system thread",
+				false, "os", &schedulerConstraint);
+			TCLAP::ValueArg<uint64_t> quantumArg("", "quantum",
+				"Number of instructions executed by a thread before it yields: round-robin scheduler switches threads "
+				"(default 1000), a system thread yields the processor (default never)",
+				false, 0, "count");
+			TCLAP::ValueArg<size_t> maxCallDepthArg("", "max-call-depth",
+				"Call stack depth limit of each evm thread (default 65536)", false, Utils::CallStack::DEFAULT_MAX_DEPTH, "count");
+			TCLAP::ValueArg<uint64_t> fuelArg("", "fuel",
+				"Instruction budget of each evm thread, checked at jumps, calls and returns (default unlimited)",
+				false, 0, "count");
+			vector<string> fuelActions{ "thread", "program" };
+			TCLAP::ValuesConstraint<string> fuelActionConstraint(fuelActions);
+			TCLAP::ValueArg<string> fuelActionArg("", "fuel-action",
+				"What happens when a thread exhausts its budget: thread - the thread ends (default), program - all threads end",
+				false, "thread", &fuelActionConstraint);
+			TCLAP::ValueArg<string> cpuSetArg("", "cpu-set",
+				"Processors for evm threads, e.g. 0-3,6 (default all available)", false, "", "cpus");
+			vector<string> affinities{ "none", "compact", "spread", "round-robin" };
+			TCLAP::ValuesConstraint<string> affinityConstraint(affinities);
+			TCLAP::ValueArg<string> affinityArg("", "affinity",
+				"Pinning of threads that execute evm threads: none - anywhere in the CPU set (default), "
+				"compact - share cores and caches, spread - one thread per physical core, round-robin - CPU set order",
+				false, "none", &affinityConstraint);
 			cmd.add(evmFilenameArg);
 			cmd.add(filenameArg);
+			cmd.add(outputFilenameArg);
+			cmd.add(outputSizeArg);
+			cmd.add(manifestArg);
 			cmd.add(traceArg);
+			cmd.add(mmapIoArg);
+			cmd.add(writeCacheArg);
+			cmd.add(asyncIoArg);
+			cmd.add(lineBufferedArg);
+			cmd.add(lockPolicyArg);
+			cmd.add(statisticsArg);
+			cmd.add(lockProfileArg);
+			cmd.add(workerPoolSizeArg);
+			cmd.add(workerPoolMaxIdleArg);
+			cmd.add(schedulerArg);
+			cmd.add(quantumArg);
+			cmd.add(maxCallDepthArg);
+			cmd.add(fuelArg);
+			cmd.add(fuelActionArg);
+			cmd.add(cpuSetArg);
+			cmd.add(affinityArg);
 
 			cmd.parse(argc, argv);
 
 			cliConfig.evmFileName = evmFilenameArg.getValue();
 			cliConfig.inputFileIsGiven = filenameArg.isSet();
 			cliConfig.inputFileName = filenameArg.getValue();
+			cliConfig.outputFileIsGiven = outputFilenameArg.isSet();
+			cliConfig.outputFileName = outputFilenameArg.getValue();
+			cliConfig.outputFileSize = outputSizeArg.getValue();
+			if (cliConfig.inputFileIsGiven && cliConfig.outputFileIsGiven &&
+				Platform::isSameFile(cliConfig.inputFileName, cliConfig.outputFileName)) {
+				// the output file is truncated when it is opened
+				throw CliConfigurationRuntimeError{ "The output file is the input file" };
+			}
+			cliConfig.manifestFileName = manifestArg.getValue();
+			cliConfig.inputFileMode = mmapIoArg.getValue() ? Utils::FileMode::Mapped : Utils::FileMode::Positional;
+			cliConfig.writeCacheSize = writeCacheArg.getValue() * 1024;
+			cliConfig.asyncIo = (asyncIoArg.getValue() == "auto") ? Utils::AsyncIoPolicy::Auto :
+				(asyncIoArg.getValue() == "threads") ? Utils::AsyncIoPolicy::Threads : Utils::AsyncIoPolicy::Off;
+			cliConfig.lineBufferedOutput = lineBufferedArg.getValue();
 			cliConfig.trace = traceArg.getValue();
+			cliConfig.lockPolicy = (lockPolicyArg.getValue() == "ticket") ? 
+				Utils::LockPolicy::Ticket : Utils::LockPolicy::Futex;
+			cliConfig.statistics = statisticsArg.getValue();
+			cliConfig.lockProfileFileName = lockProfileArg.getValue();
+			cliConfig.workerPoolSize = workerPoolSizeArg.getValue();
+			cliConfig.workerPoolMaxIdle = workerPoolMaxIdleArg.getValue();
+			cliConfig.scheduler = (schedulerArg.getValue() == "rr") ?
+				SchedulerPolicy::RoundRobin : SchedulerPolicy::Os;
+			cliConfig.quantum = quantumArg.getValue();
+			cliConfig.maxCallDepth = maxCallDepthArg.getValue();
+			cliConfig.fuel = fuelArg.getValue();
+			cliConfig.fuelAction = (fuelActionArg.getValue() == "program") ? FuelAction::Program : FuelAction::Thread;
+			cliConfig.cpuSet = Utils::parseCpuSet(cpuSetArg.getValue());
+			const auto & affinity = affinityArg.getValue();
+			cliConfig.affinity = (affinity == "compact") ? Utils::AffinityPolicy::Compact :
+				(affinity == "spread") ? Utils::AffinityPolicy::Spread :
+				(affinity == "round-robin") ? Utils::AffinityPolicy::RoundRobin : Utils::AffinityPolicy::None;
 		}
 		catch (TCLAP::ArgException &e)  // catch any exceptions
 		{
@@ -17,6 +17,18 @@
 #include "Memory.h"
 #include "BitBuffer.h"
 #include "EvmFile.h"
+#include "LockTable.h"
+#include "LockProfiler.h"
+#include "WorkerPool.h"
+#include "Scheduler.h"
+#include "CpuPlacement.h"
+#include "CallStack.h"
+#include "Program.h"
+#include "InputFile.h"
+#include "AsyncIo.h"
+#include "FileTable.h"
+#include "ConsoleOutput.h"
+#include "ConsoleInput.h"
 
 struct ThreadContext;
 
@@ -24,6 +36,12 @@ struct ThreadContext;
 //!
 //! Main namespace of Evm library
 namespace Evm {
+	//! @brief Action taken when a thread exhausts its instruction budget
+	enum class FuelAction {
+		Thread,		//!< The thread is terminated
+		Program		//!< All threads are terminated
+	};
+
 	//! @brief Evm configuration
 	//!
 	//! Configuration structure for Evm Application. Can be filled by hand or captured from
@@ -32,7 +50,28 @@ namespace Evm {
 		string evmFileName;		//!< File name of .evm executable
 		string inputFileName;	//!< File name of user input file (if it is required)
 		bool inputFileIsGiven;	//!< True if the input file is given.
+		string outputFileName;	//!< File name of user output file, writes go to the input file if it isn't given
+		bool outputFileIsGiven = false;	//!< True if the output file is given, the input file is read only then
+		uint64_t outputFileSize = 0;	//!< Expected size of the output file in bytes, allocated in advance, 0 - unknown
+		string manifestFileName;		//!< File name of the manifest, files opened by evm open instruction, none if empty
+		Utils::FileMode inputFileMode = Utils::FileMode::Positional;	//!< Implementation of the written file
+		uint64_t writeCacheSize = 0;	//!< Dirty data limit of written file write-back cache in bytes, 0 - no cache
+		Utils::AsyncIoPolicy asyncIo = Utils::AsyncIoPolicy::Off;	//!< Asynchronous I/O backend of the input file
+		bool lineBufferedOutput = false;	//!< True if console output is flushed after each line, always if it is a terminal
 		bool trace;				//!< True if command execution trace is enabled
+		Utils::LockPolicy lockPolicy = Utils::LockPolicy::Futex;	//!< Implementation of evm locks
+		bool statistics = false;	//!< True if execution statistics are printed at exit
+		string lockProfileFileName;	//!< File name of JSON lock profile, lock profiling is disabled if empty
+		size_t workerPoolSize = 0;		//!< Number of system threads spawned in advance
+		size_t workerPoolMaxIdle = 64;	//!< Number of idle system threads kept for reuse
+		SchedulerPolicy scheduler = SchedulerPolicy::Os;	//!< Where evm threads are executed
+		uint64_t quantum = 0;			//!< Instructions per time slice, 0 - default (RoundRobinScheduler::DEFAULT_QUANTUM for
+										//!< round-robin scheduler, system threads never yield)
+		size_t maxCallDepth = Utils::CallStack::DEFAULT_MAX_DEPTH;	//!< Call stack depth limit of each thread
+		uint64_t fuel = 0;				//!< Instruction budget of each thread, 0 - unlimited
+		FuelAction fuelAction = FuelAction::Thread;	//!< What happens when the budget is exhausted
+		Utils::AffinityPolicy affinity = Utils::AffinityPolicy::None;	//!< Placement of system threads on processors
+		vector<uint32_t> cpuSet;		//!< Processors for evm threads, all processors if empty
 	};
 
 	//! @brief Main EVM application class
@@ -42,9 +81,12 @@ namespace Evm {
 	//! It also provides data and program memories, thread list, locks list input file as well as
 	//! interfaces to these objects.
 	struct Application {
-		using ThreadContexPtr = unique_ptr<ThreadContext>;
-		using ThreadList = vector<ThreadContexPtr>;
-		using LockList = map<uint64_t, mutex>;
+		using ThreadContexPtr = shared_ptr<ThreadContext>;
+		using ThreadList = unordered_map<uint64_t, ThreadContexPtr>;
+		using ContextPool = vector<unique_ptr<ThreadContext>>;
+
+		static constexpr size_t MAX_POOLED_CONTEXTS = 64;	//!< Limit of recycled contexts kept for reuse
+		using LockList = Utils::LockTable;
 
 		//! @brief Constructor
 		//!
@@ -68,10 +110,22 @@ namespace Evm {
 		//!
 		//! The function waits until the main evm thread is done.
 		//! If the main thread is done, other threads are terminated and joined.
+		//! Terminated threads are woken from sleep, lock waits are cancelled, so
+		//! the shutdown doesn't wait for blocking evm instructions.
+		//! Errors, e.g. a deadlock under round-robin scheduler, are thrown after
+		//! the threads are disposed and the files are flushed.
 		//! @note This is blocking function
 		//! @throw RuntimeError
 		void wait();
 
+		//! @brief Terminate the program
+		//!
+		//! API function for evm library. Terminate all evm threads and cancel lock waits,
+		//! e.g. when a thread exhausts its instruction budget. wait() returns when
+		//! the main thread leaves its execution loop.
+		//! @note This is non-blocking function
+		void terminate();
+
 		//! @brief Spawn new evm thread
 		//!
 		//! API function for evm library. The function creates new evm thread based on caller. 
@@ -86,11 +140,22 @@ namespace Evm {
 		//! @brief Join a thread
 		//!
 		//! API function for evm library. Suspend current thread execution until 
-		//! a thread with given ID is done
+		//! a thread with given ID is done. Joining already disposed thread returns immediately.
+		//! Under round-robin scheduler the caller yields instead of blocking.
 		//! @note This is blocking function
+		//! @param caller reference to caller thread
 		//! @param threadId id of a related thread
 		//! @throw RuntimeError
-		void joinThread(uint64_t threadId);
+		void joinThread(ThreadContext & caller, uint64_t threadId);
+
+		//! @brief Dispose a finished thread
+		//!
+		//! Called by the executor of the thread after it is finished, joined or not.
+		//! The thread is removed from the thread list and its context is recycled
+		//! when the last reference is dropped.
+		//! @note The thread must not be touched afterwards
+		//! @param threadId id of the finished thread
+		void threadFinished(uint64_t threadId);
 
 		//! @brief Obtain a lock
 		//!
@@ -98,15 +163,19 @@ namespace Evm {
 		//! When the lock doesn't exist it will be created. If the lock is
 		//! already obtained, the thread will be suspended.
 		//! @note The function is blocking when the lock is already obtained\n
-		//! otherwise is is non-blocking
+		//! otherwise is is non-blocking. At shutdown the wait is cancelled, the function
+		//! returns without the lock and the terminated caller leaves its execution loop.
+		//! Under round-robin scheduler the caller yields instead of blocking.
+		//! @param caller reference to caller thread
 		//! @param lockID ID of the lock
 		//! @throw RuntimeError
-		void lock(uint64_t lockID);
+		void lock(ThreadContext & caller, uint64_t lockID);
 
 		//! @brief Release a lock
 		//!
 		//! API function for evm library. Release a lock with given ID.
 		//! When the lock doesn't exist BadLockIDRuntimeError exception will be thrown
+		//! The lock may be released by other thread than the one that obtained it.
 		//! @note This is non-blocking function
 		//! @param lockID ID of the lock
 		//! @throw RuntimeError
@@ -125,6 +194,12 @@ namespace Evm {
 		//! @return reference to program memory
 		const Utils::BitBuffer & programMemory() const;
 
+		//! @brief Get reference to verified program
+		//!
+		//! API function for evm library. Predecoded instructions of verified code.
+		//! @return reference to the program
+		const Program & program() const;
+
 		//! @brief Get reference to input file
 		//!
 		//! The function returns reference to inpute file, but only if the file is given.
@@ -132,7 +207,40 @@ namespace Evm {
 		//! exception
 		//! @return reference to input file
 		//! @throw RuntimeError
-		fstream & inputFile();
+		Utils::IFile & inputFile();
+
+		//! @brief Get reference to output file
+		//!
+		//! The file written by evm write instructions, the output file if it is given,
+		//! the input file otherwise.
+		//! @return reference to output file
+		//! @throw RuntimeError
+		Utils::IFile & outputFile();
+
+		//! @brief Get file table
+		//!
+		//! API function for evm library. Files of the manifest opened by evm program.
+		//! @return reference to file table
+		Utils::FileTable & fileTable();
+
+		//! @brief Get asynchronous I/O backend
+		//!
+		//! API function for evm library.
+		//! @return The backend, nullptr if transfers are done by the issuing thread. It is always
+		//!		nullptr if evm threads run on system threads.
+		Utils::IAsyncIo * asyncIo();
+
+		//! @brief Get console output
+		//!
+		//! API function for evm library. Sink of consoleWrite.
+		//! @return reference to console output
+		Utils::ConsoleOutput & consoleOutput();
+
+		//! @brief Get console input
+		//!
+		//! API function for evm library. Source of consoleRead.
+		//! @return reference to console input
+		Utils::ConsoleInput & consoleInput();
 
 		//! @brief Get input file name
 		//!
@@ -142,6 +250,39 @@ namespace Evm {
 
 		const CliConfiguration & configuartion() const;
 
+		//! @brief Get reference to worker pool
+		//!
+		//! API function for evm library. System threads that execute evm threads.
+		//! @return reference to worker pool
+		Utils::WorkerPool & workerPool();
+
+		//! @brief Get pointer to round-robin scheduler
+		//!
+		//! API function for evm library.
+		//! @return pointer to the scheduler, nullptr if evm threads run on system threads
+		RoundRobinScheduler * scheduler();
+
+		//! @brief Get reference to CPU placement
+		//!
+		//! API function for evm library. Evm threads record where they ran.
+		//! @return reference to CPU placement
+		Utils::CpuPlacement & cpuPlacement();
+
+		//! @brief Print execution statistics
+		//!
+		//! Print run time and lock contention statistics (including wait time
+		//! percentiles) and placement of threads on processors. Call it after wait().
+		//! @param os Output stream
+		void printStatistics(ostream & os);
+
+		//! @brief Write lock profile
+		//!
+		//! Print lock profile table and write it as JSON file, but only if lock profiling
+		//! is enabled. Call it after wait().
+		//! @param os Output stream for the table
+		//! @throw RuntimeError
+		void printLockProfile(ostream & os);
+
 		Application() = delete;
 		Application(const Application &) = delete;
 		Application(Application &&) = delete;
@@ -152,11 +293,32 @@ namespace Evm {
 		const CliConfiguration _config;
 		unique_ptr<File::EvmFile> _evm;	//!< Pointer to evm file structure
 		const Utils::BitBuffer _programMemory;	//!< Program memory as bit buffer
+		const Program _program;					//!< Verified and predecoded program memory
 		Utils::Memory _dataMemory;				//!< Data memory
-		ThreadList _threadList;			//!< List of evm threads
-		LockList _lockList;				//!< Directory with evm locks
-		fstream _inputFileStream;		//!< Stream to the input file. 
-										//!< Valid only when _isInputFileGiven is true.
+		Utils::CpuPlacement _cpuPlacement;	//!< Pins worker threads to processors
+		Utils::WorkerPool _workerPool;	//!< System threads, destroyed after all contexts
+		unique_ptr<RoundRobinScheduler> _scheduler;	//!< Round-robin scheduler, null if threads run on system threads
+		mutex _threadListGuard;			//!< Protects thread list, context pool and thread counters
+		ContextPool _contextPool;		//!< Finished and disposed contexts ready for reuse
+		ThreadList _threadList;			//!< Evm threads that haven't finished yet
+		ThreadContexPtr _mainThread;	//!< The first evm thread
+		uint64_t _nextThreadID = 0;		//!< ID of next evm thread, IDs are never reused
+		uint64_t _recycledThreads = 0;	//!< Number of threads that reused a pooled context
+		size_t _liveThreadCount = 0;	//!< Number of started and not disposed threads
+		size_t _peakThreadCount = 0;	//!< The greatest number of live threads
+		condition_variable _threadExited;	//!< Signaled when a thread is disposed
+		size_t _peakCallDepth = 0;		//!< The greatest call stack depth of disposed threads
+		bool _isShuttingDown = false;	//!< True when the main thread is done
+		LockList _lockList;				//!< Concurrent directory with evm locks
+		unique_ptr<Utils::LockProfiler> _lockProfiler;	//!< Lock profiler, null if profiling is disabled
+		Utils::FilePtr _inputFile;		//!< The input file, null if it is not given
+		Utils::FilePtr _outputFile;		//!< The output file, null if it is not given
+		Utils::FileTable _fileTable;	//!< Files of the manifest opened by evm program
+		Utils::AsyncIoPtr _asyncIo;		//!< Asynchronous I/O of user files, null if it is disabled
+		Utils::ConsoleOutput _consoleOutput;	//!< Buffered console output, flushed at the latest on destruction
+		Utils::ConsoleInput _consoleInput;		//!< Buffered and parsed console input
+		chrono::steady_clock::time_point _startTime;	//!< Time of run()
+		chrono::steady_clock::time_point _endTime;		//!< Time when wait() is done
 
 		//! @brief Helper function. Open and parse evm file, it fill and validate.
 		//!
@@ -165,6 +327,23 @@ namespace Evm {
 
 		//! @brief Helper function. Initialize program memory with data from evm file
 		Utils::BitBuffer _extractProgramMemory(const File::EvmFile & evm) const;
+
+		//! @brief Helper function. Make new thread context and add it to thread list
+		//!
+		//! The context is taken from the pool if possible. When the last reference
+		//! to the context is dropped, it is returned to the pool.
+		//! @note Call it with _threadListGuard locked
+		//! @param caller Pointer to caller thread, nullptr for the main thread
+		//! @param address Initial program counter
+		ThreadContexPtr _makeThread(const ThreadContext * caller, uint32_t address);
+
+		//! @brief Helper function. Count a thread that is about to run
+		//!
+		//! @note Call it with _threadListGuard locked
+		void _threadStarted();
+
+		//! @brief Helper function. Return finished context to the pool
+		void _recycleThread(ThreadContext * thread);
 	};
 
 	//! @brief Get evm configuration from cli
@@ -9,15 +9,6 @@
 
 namespace Evm {
 	namespace Argument {
-		//! Use during bytes conversion to BYTEs, WORDs, DWORDs and QWORDs
-		//! It is also good for big- little-endian convertion
-		union ConvertUnion {
-			uint64_t u64;
-			uint32_t u32[2];
-			uint16_t u16[4];
-			uint8_t u8[8];
-		};
-
 		ArgumentPtr getRegisterArgument(const Utils::BitBuffer & programMemory, uint32_t & offset)
 		{
 			ArgumentPtr arg = nullptr;
@@ -61,9 +52,6 @@ namespace Evm {
 				(void)e;
 				throw ProgramMemoryOutOfRangeRuntimeError{};
 			}
-			catch (RuntimeError & e) {
-				throw e;
-			}
 
 			return arg;
 		}
@@ -94,14 +82,84 @@ namespace Evm {
 			}
 		}
 
-		uint64_t RegisterArgument::getValue(ThreadContext & thread) const
+		ArgumentPtr getUncheckedMemoryArgument(uint8_t registerIndex, uint64_t size)
+		{
+			switch (size) {
+			case MemoryBYTEArgument::SIZE:
+				return make_unique<UncheckedMemoryArgument<MemoryBYTEArgument>>(registerIndex);
+			case MemoryWORDArgument::SIZE:
+				return make_unique<UncheckedMemoryArgument<MemoryWORDArgument>>(registerIndex);
+			case MemoryDWORDArgument::SIZE:
+				return make_unique<UncheckedMemoryArgument<MemoryDWORDArgument>>(registerIndex);
+			case MemoryQWORDArgument::SIZE:
+				return make_unique<UncheckedMemoryArgument<MemoryQWORDArgument>>(registerIndex);
+			default:
+				return nullptr;
+			}
+		}
+
+		uint64_t IArgument::getValue(ThreadContext & thread) const
+		{
+			uint64_t value;
+			if (load(thread, value) != Fault::None) {
+				throwFault(thread.fault());
+			}
+			return value;
+		}
+
+		void IArgument::setValue(ThreadContext & thread, uint64_t value)
+		{
+			if (store(thread, value) != Fault::None) {
+				throwFault(thread.fault());
+			}
+		}
+
+		Fault IRegisterBaseArgument::_load(ThreadContext & thread, uint64_t size, uint64_t & value) const
+		{
+			auto & memory = thread.application()->dataMemory();
+			uint64_t address = thread.core().reg(_regIndex);
+			if (!memory.load(address, size, value)) {
+				return thread.raise(Fault::DataMemoryRead, address, size, memory.size());
+			}
+			return Fault::None;
+		}
+
+		Fault IRegisterBaseArgument::_store(ThreadContext & thread, uint64_t size, uint64_t value) const
+		{
+			auto & memory = thread.application()->dataMemory();
+			uint64_t address = thread.core().reg(_regIndex);
+			if (!memory.store(address, size, value)) {
+				return thread.raise(Fault::DataMemoryWrite, address, size, memory.size());
+			}
+			return Fault::None;
+		}
+
+		uint64_t IRegisterBaseArgument::_loadUnchecked(ThreadContext & thread, uint64_t size) const
+		{
+			return thread.application()->dataMemory().loadUnchecked(thread.core().reg(_regIndex), size);
+		}
+
+		void IRegisterBaseArgument::_storeUnchecked(ThreadContext & thread, uint64_t size, uint64_t value) const
+		{
+			thread.application()->dataMemory().storeUnchecked(thread.core().reg(_regIndex), size, value);
+		}
+
+		Fault RegisterArgument::load(ThreadContext & thread, uint64_t & value) const
+		{
+			value = thread.core().reg(_regIndex);
+			return Fault::None;
+		}
+
+		Fault RegisterArgument::store(ThreadContext & thread, uint64_t value)
 		{
-			return thread.reg(_regIndex);
+			thread.core().reg(_regIndex) = value;
+			return Fault::None;
 		}
 
-		void RegisterArgument::setValue(ThreadContext & thread, uint64_t value)
+		bool RegisterArgument::registerOperand(uint8_t & index) const
 		{
-			thread.reg(_regIndex, value);
+			index = _regIndex;
+			return true;
 		}
 
 		string RegisterArgument::label() const
@@ -116,39 +174,21 @@ namespace Evm {
 			return oss.str();
 		}
 
-		uint64_t MemoryBYTEArgument::getValue(ThreadContext & thread) const
+		Fault MemoryBYTEArgument::load(ThreadContext & thread, uint64_t & value) const
 		{
-			try {
-				auto & memory = thread.application()->dataMemory();
-				uint64_t address = thread.reg(_regIndex);
-
-				Bytes data = memory.read(address, 1);
-
-				return static_cast<uint64_t>(data.at(0));
-			}
-			catch (out_of_range & e) {
-				throw DataMemoryOutOfRangeRuntimeError{ string{e.what()} };
-			}
-			catch (RuntimeError & e) {
-				throw e;
-			}
+			return _load(thread, 1, value);
 		}
-		void MemoryBYTEArgument::setValue(ThreadContext & thread, uint64_t value)
+
+		Fault MemoryBYTEArgument::store(ThreadContext & thread, uint64_t value)
 		{
-			try {
-				auto & memory = thread.application()->dataMemory();
-				uint64_t address = thread.reg(_regIndex);
+			return _store(thread, 1, value);
+		}
 
-				Byte byte = static_cast<Byte>(value);
-				Bytes data{ byte };
-				memory.write(address, data);
-			}
-			catch (out_of_range & e) {
-				throw DataMemoryOutOfRangeRuntimeError{ string{ e.what() } };
-			}
-			catch (RuntimeError & e) {
-				throw e;
-			}
+		bool MemoryBYTEArgument::memoryOperand(uint8_t & index, uint64_t & size) const
+		{
+			index = _regIndex;
+			size = SIZE;
+			return true;
 		}
 
 		string MemoryBYTEArgument::label() const
@@ -159,54 +199,27 @@ namespace Evm {
 		string MemoryBYTEArgument::printValue(ThreadContext & thread) const
 		{
 			ostringstream oss;
-			uint64_t address = thread.reg(_regIndex);
+			uint64_t address = thread.core().reg(_regIndex);
 			oss << "BYTE:add:0x" << setfill('0') << setw(16) << hex << address << ":0x" 
 				<< setfill('0') << setw(2) << hex << getValue(thread);
 			return oss.str();
 		}
 
-		uint64_t MemoryWORDArgument::getValue(ThreadContext & thread) const
+		Fault MemoryWORDArgument::load(ThreadContext & thread, uint64_t & value) const
 		{
-			try {
-				auto & memory = thread.application()->dataMemory();
-				uint64_t address = thread.reg(_regIndex);
-
-				Bytes data = memory.read(address, 2);
-
-				ConvertUnion cu;
-				cu.u8[0] = data.at(0);
-				cu.u8[1] = data.at(1);
-
-				return static_cast<uint64_t>(cu.u16[0]);
-			}
-			catch (out_of_range & e) {
-				throw DataMemoryOutOfRangeRuntimeError{ string{ e.what() } };
-			}
-			catch (RuntimeError & e) {
-				throw e;
-			}
+			return _load(thread, 2, value);
 		}
 
-		void MemoryWORDArgument::setValue(ThreadContext & thread, uint64_t value)
+		Fault MemoryWORDArgument::store(ThreadContext & thread, uint64_t value)
 		{
-			try {
-				auto & memory = thread.application()->dataMemory();
-				uint64_t address = thread.reg(_regIndex);
-
-				ConvertUnion cu;
-				cu.u64 = value;
-				Byte byte0 = static_cast<Byte>(cu.u8[0]);
-				Byte byte1 = static_cast<Byte>(cu.u8[1]);
+			return _store(thread, 2, value);
+		}
 
-				Bytes data{ byte0, byte1 };
-				memory.write(address, data);
-			}
-			catch (out_of_range & e) {
-				throw DataMemoryOutOfRangeRuntimeError{ string{ e.what() } };
-			} 
-			catch (RuntimeError & e) {
-				throw e;
-			}
+		bool MemoryWORDArgument::memoryOperand(uint8_t & index, uint64_t & size) const
+		{
+			index = _regIndex;
+			size = SIZE;
+			return true;
 		}
 
 		string MemoryWORDArgument::label() const
@@ -217,58 +230,27 @@ namespace Evm {
 		string MemoryWORDArgument::printValue(ThreadContext & thread) const
 		{
 			ostringstream oss;
-			uint64_t address = thread.reg(_regIndex);
+			uint64_t address = thread.core().reg(_regIndex);
 			oss << "WORD:add:0x" << setfill('0') << setw(16) << hex << address << ":0x" 
 				<< setfill('0') << setw(4) << hex << getValue(thread);
 			return oss.str();
 		}
 
-		uint64_t MemoryDWORDArgument::getValue(ThreadContext & thread) const
+		Fault MemoryDWORDArgument::load(ThreadContext & thread, uint64_t & value) const
 		{
-			try {
-				auto & memory = thread.application()->dataMemory();
-				uint64_t address = thread.reg(_regIndex);
-
-				Bytes data = memory.read(address, 4);
-
-				ConvertUnion cu;
-				cu.u8[0] = data.at(0);
-				cu.u8[1] = data.at(1);
-				cu.u8[2] = data.at(2);
-				cu.u8[3] = data.at(3);
+			return _load(thread, 4, value);
+		}
 
-				return static_cast<uint64_t>(cu.u32[0]);
-			}
-			catch (out_of_range & e) {
-				throw DataMemoryOutOfRangeRuntimeError{ string{ e.what() } };
-			}
-			catch (RuntimeError & e) {
-				throw e;
-			}
+		Fault MemoryDWORDArgument::store(ThreadContext & thread, uint64_t value)
+		{
+			return _store(thread, 4, value);
 		}
 
-		void MemoryDWORDArgument::setValue(ThreadContext & thread, uint64_t value)
+		bool MemoryDWORDArgument::memoryOperand(uint8_t & index, uint64_t & size) const
 		{
-			try {
-				auto & memory = thread.application()->dataMemory();
-				uint64_t address = thread.reg(_regIndex);
-
-				ConvertUnion cu;
-				cu.u64 = value;
-				Byte byte0 = static_cast<Byte>(cu.u8[0]);
-				Byte byte1 = static_cast<Byte>(cu.u8[1]);
-				Byte byte2 = static_cast<Byte>(cu.u8[2]);
-				Byte byte3 = static_cast<Byte>(cu.u8[3]);
-
-				Bytes data{ byte0, byte1, byte2, byte3 };
-				memory.write(address, data);
-			}
-			catch (out_of_range & e) {
-				throw DataMemoryOutOfRangeRuntimeError{ string{ e.what() } };
-			}
-			catch (RuntimeError & e) {
-				throw e;
-			}
+			index = _regIndex;
+			size = SIZE;
+			return true;
 		}
 
 		string MemoryDWORDArgument::label() const
@@ -279,65 +261,27 @@ namespace Evm {
 		string MemoryDWORDArgument::printValue(ThreadContext & thread) const
 		{
 			ostringstream oss;
-			uint64_t address = thread.reg(_regIndex);
+			uint64_t address = thread.core().reg(_regIndex);
 			oss << "DWORD:add:0x" << setfill('0') << setw(16) << hex << address << ":"
 				<< setfill('0') << setw(8) << hex << getValue(thread);
 			return oss.str();
 		}
 
-		uint64_t MemoryQWORDArgument::getValue(ThreadContext & thread) const
+		Fault MemoryQWORDArgument::load(ThreadContext & thread, uint64_t & value) const
 		{
-			try {
-				auto & memory = thread.application()->dataMemory();
-				uint64_t address = thread.reg(_regIndex);
-
-				Bytes data = memory.read(address, 8);
-
-				ConvertUnion cu;
-				cu.u8[0] = data.at(0);
-				cu.u8[1] = data.at(1);
-				cu.u8[2] = data.at(2);
-				cu.u8[3] = data.at(3);
-				cu.u8[4] = data.at(4);
-				cu.u8[5] = data.at(5);
-				cu.u8[6] = data.at(6);
-				cu.u8[7] = data.at(7);
-
-				return cu.u64;
-			}
-			catch (out_of_range & e) {
-				throw DataMemoryOutOfRangeRuntimeError{ string{ e.what() } };
-			}
-			catch (RuntimeError & e) {
-				throw e;
-			}
+			return _load(thread, 8, value);
 		}
-		void MemoryQWORDArgument::setValue(ThreadContext & thread, uint64_t value)
+
+		Fault MemoryQWORDArgument::store(ThreadContext & thread, uint64_t value)
 		{
-			try {
-				auto & memory = thread.application()->dataMemory();
-				uint64_t address = thread.reg(_regIndex);
-
-				ConvertUnion cu;
-				cu.u64 = value;
-				Byte byte0 = static_cast<Byte>(cu.u8[0]);
-				Byte byte1 = static_cast<Byte>(cu.u8[1]);
-				Byte byte2 = static_cast<Byte>(cu.u8[2]);
-				Byte byte3 = static_cast<Byte>(cu.u8[3]);
-				Byte byte4 = static_cast<Byte>(cu.u8[4]);
-				Byte byte5 = static_cast<Byte>(cu.u8[5]);
-				Byte byte6 = static_cast<Byte>(cu.u8[6]);
-				Byte byte7 = static_cast<Byte>(cu.u8[7]);
-
-				Bytes data{ byte0, byte1, byte2, byte3, byte4, byte5, byte6, byte7 };
-				memory.write(address, data);
-			}
-			catch (out_of_range & e) {
-				throw DataMemoryOutOfRangeRuntimeError{ string{ e.what() } };
-			}
-			catch (RuntimeError & e) {
-				throw e;
-			}
+			return _store(thread, 8, value);
+		}
+
+		bool MemoryQWORDArgument::memoryOperand(uint8_t & index, uint64_t & size) const
+		{
+			index = _regIndex;
+			size = SIZE;
+			return true;
 		}
 
 		string MemoryQWORDArgument::label() const
@@ -348,20 +292,27 @@ namespace Evm {
 		string MemoryQWORDArgument::printValue(ThreadContext & thread) const
 		{
 			ostringstream oss;
-			uint64_t address = thread.reg(_regIndex);
+			uint64_t address = thread.core().reg(_regIndex);
 			oss << "QWORD:add:0x" << setfill('0') << setw(16) << hex << address << ":0x"
 				<< setfill('0') << setw(16) << hex << getValue(thread);
 			return oss.str();
 		}
 
-		uint64_t ConstArgument::getValue(ThreadContext & thread) const
+		Fault ConstArgument::load(ThreadContext & /*thread*/, uint64_t & value) const
+		{
+			value = _constValue;
+			return Fault::None;
+		}
+
+		Fault ConstArgument::store(ThreadContext & thread, uint64_t /*value*/)
 		{
-			return _constValue;
+			return thread.raise(Fault::WriteToConst);
 		}
 
-		void ConstArgument::setValue(ThreadContext & thread, uint64_t value)
+		bool ConstArgument::constValue(uint64_t & value) const
 		{
-			throw WriteToConstRuntimeError{};
+			value = _constValue;
+			return true;
 		}
 
 		string ConstArgument::label() const
@@ -376,15 +327,23 @@ namespace Evm {
 			return oss.str();
 		}
 
-		uint64_t AddressArgument::getValue(ThreadContext & thread) const
+		Fault AddressArgument::load(ThreadContext & /*thread*/, uint64_t & value) const
+		{
+			value = static_cast<uint64_t>(_value);
+			return Fault::None;
+		}
+
+		Fault AddressArgument::store(ThreadContext & thread, uint64_t /*value*/)
 		{
-			return static_cast<uint64_t>(_value);
+			return thread.raise(Fault::WriteToConst);
 		}
 
-		void AddressArgument::setValue(ThreadContext & thread, uint64_t value)
+		bool AddressArgument::constValue(uint64_t & value) const
 		{
-			throw WriteToConstRuntimeError{};
+			value = static_cast<uint64_t>(_value);
+			return true;
 		}
+
 		string AddressArgument::label() const
 		{
 			return "address";
@@ -14,11 +14,14 @@
 //! The IArgument interface has two classes responsible of printing the arguemnt.
 //! label() function prints readable form of the argument.
 //! printValue() returns label as well as value of the parameter in runtime
+//! Operations access values with load() and store(), which report errors as
+//! a @ref Fault code. getValue() and setValue() are throwing wrappers for the rest.
 #pragma once
 
 #include "stdafx.h"
 #include "ThreadContext.h"
 #include "BitBuffer.h"
+#include "Fault.h"
 
 namespace Evm {
 	namespace Argument {
@@ -26,12 +29,29 @@ namespace Evm {
 			//! @brief Virtual destructor
 			virtual ~IArgument() = default;
 
+			//! @brief Load value
+			//!
+			//! Fast path of operations, errors are returned as a fault code
+			//! @param thread Thread context within this argument is used
+			//! @param value Output, value of the parameter
+			//! @return Fault::None or the fault recorded in the thread
+			virtual Fault load(ThreadContext & thread, uint64_t & value) const = 0;
+
+			//! @brief Store value
+			//!
+			//! Fast path of operations, errors are returned as a fault code
+			//! @param thread Thread context within this argument is used
+			//! @param value New value of the parameter
+			//! @return Fault::None or the fault recorded in the thread
+			virtual Fault store(ThreadContext & thread, uint64_t value) = 0;
+
 			//! @brief Get value
 			//!
 			//! Return value of the argument
 			//! @param thread Thread context within this argument is used
 			//! @return Value of the parameter
-			virtual uint64_t getValue(ThreadContext & thread) const = 0;
+			//! @throw RuntimeError
+			uint64_t getValue(ThreadContext & thread) const;
 
 			//! @brief Set value
 			//!
@@ -39,7 +59,36 @@ namespace Evm {
 			//! @warning For read-only arguments this throws an exception
 			//! @param thread Thread context within this argument is used
 			//! @param value New value of the parameter
-			virtual void setValue(ThreadContext & thread, uint64_t value) = 0;
+			//! @throw RuntimeError
+			void setValue(ThreadContext & thread, uint64_t value);
+
+			//! @brief Get value known at load time
+			//!
+			//! Used by static analysis of the program
+			//! @param value Output, value of constant and address arguments
+			//! @return False if the value depends on thread state
+			virtual bool constValue(uint64_t & /*value*/) const {
+				return false;
+			}
+
+			//! @brief Get register of register argument
+			//!
+			//! Used by static analysis of the program
+			//! @param index Output, index of the register
+			//! @return False if the argument is not rX
+			virtual bool registerOperand(uint8_t & /*index*/) const {
+				return false;
+			}
+
+			//! @brief Get address register and size of memory argument
+			//!
+			//! Used by static analysis of the program
+			//! @param index Output, index of the register with the address
+			//! @param size Output, access size in bytes
+			//! @return False if the argument is not a memory argument
+			virtual bool memoryOperand(uint8_t & /*index*/, uint64_t & /*size*/) const {
+				return false;
+			}
 
 			//! @brief Get printable representation of the argument
 			//!
@@ -69,53 +118,100 @@ namespace Evm {
 			{}
 		protected:
 			uint8_t _regIndex;	//!< Register index
+
+			//! @brief Helper function. Load from data memory at address in the register
+			//! @param size Access size in bytes
+			Fault _load(ThreadContext & thread, uint64_t size, uint64_t & value) const;
+
+			//! @brief Helper function. Store to data memory at address in the register
+			//! @param size Access size in bytes
+			Fault _store(ThreadContext & thread, uint64_t size, uint64_t value) const;
+
+			//! @brief Helper function. _load() without bounds check
+			uint64_t _loadUnchecked(ThreadContext & thread, uint64_t size) const;
+
+			//! @brief Helper function. _store() without bounds check
+			void _storeUnchecked(ThreadContext & thread, uint64_t size, uint64_t value) const;
 		};
 
 		//! @brief Register argument (rX)
 		struct RegisterArgument : IRegisterBaseArgument {
 			using IRegisterBaseArgument::IRegisterBaseArgument;
-			virtual uint64_t getValue(ThreadContext & thread) const override;
-			virtual void setValue(ThreadContext & thread, uint64_t value) override;
+			virtual Fault load(ThreadContext & thread, uint64_t & value) const override;
+			virtual Fault store(ThreadContext & thread, uint64_t value) override;
+			virtual bool registerOperand(uint8_t & index) const override;
 			virtual string label() const override;
 			virtual string printValue(ThreadContext & thread) const override;
 		};
 
 		//! @brief Memory BYTE[rX] argument
 		struct MemoryBYTEArgument : IRegisterBaseArgument {
+			static constexpr uint64_t SIZE = 1;	//!< Access size in bytes
+
 			using IRegisterBaseArgument::IRegisterBaseArgument;
-			virtual uint64_t getValue(ThreadContext & thread) const override;
-			virtual void setValue(ThreadContext & thread, uint64_t value) override;
+			virtual Fault load(ThreadContext & thread, uint64_t & value) const override;
+			virtual Fault store(ThreadContext & thread, uint64_t value) override;
+			virtual bool memoryOperand(uint8_t & index, uint64_t & size) const override;
 			virtual string label() const override;
 			virtual string printValue(ThreadContext & thread) const override;
 		};
 
 		//! @brief Memory WORD[rX] argument
 		struct MemoryWORDArgument : IRegisterBaseArgument {
+			static constexpr uint64_t SIZE = 2;	//!< Access size in bytes
+
 			using IRegisterBaseArgument::IRegisterBaseArgument;
-			virtual uint64_t getValue(ThreadContext & thread) const override;
-			virtual void setValue(ThreadContext & thread, uint64_t value) override;
+			virtual Fault load(ThreadContext & thread, uint64_t & value) const override;
+			virtual Fault store(ThreadContext & thread, uint64_t value) override;
+			virtual bool memoryOperand(uint8_t & index, uint64_t & size) const override;
 			virtual string label() const override;
 			virtual string printValue(ThreadContext & thread) const override;
 		};
 
 		//! @brief Memory DWORD[rX] argument
 		struct MemoryDWORDArgument : IRegisterBaseArgument {
+			static constexpr uint64_t SIZE = 4;	//!< Access size in bytes
+
 			using IRegisterBaseArgument::IRegisterBaseArgument;
-			virtual uint64_t getValue(ThreadContext & thread) const override;
-			virtual void setValue(ThreadContext & thread, uint64_t value) override;
+			virtual Fault load(ThreadContext & thread, uint64_t & value) const override;
+			virtual Fault store(ThreadContext & thread, uint64_t value) override;
+			virtual bool memoryOperand(uint8_t & index, uint64_t & size) const override;
 			virtual string label() const override;
 			virtual string printValue(ThreadContext & thread) const override;
 		};
 
 		//! @brief Memory QWORD[rX] argument
 		struct MemoryQWORDArgument : IRegisterBaseArgument {
+			static constexpr uint64_t SIZE = 8;	//!< Access size in bytes
+
 			using IRegisterBaseArgument::IRegisterBaseArgument;
-			virtual uint64_t getValue(ThreadContext & thread) const override;
-			virtual void setValue(ThreadContext & thread, uint64_t value) override;
+			virtual Fault load(ThreadContext & thread, uint64_t & value) const override;
+			virtual Fault store(ThreadContext & thread, uint64_t value) override;
+			virtual bool memoryOperand(uint8_t & index, uint64_t & size) const override;
 			virtual string label() const override;
 			virtual string printValue(ThreadContext & thread) const override;
 		};
 
+		//! @brief Memory argument proven in range
+		//!
+		//! Memory argument that skips the bounds check. Used by Program for accesses
+		//! that range analysis has proven to be within data memory.
+		//! @tparam MemoryArgument One of Memory*Argument classes
+		template <typename MemoryArgument>
+		struct UncheckedMemoryArgument : MemoryArgument {
+			using MemoryArgument::MemoryArgument;
+
+			virtual Fault load(ThreadContext & thread, uint64_t & value) const override {
+				value = this->_loadUnchecked(thread, MemoryArgument::SIZE);
+				return Fault::None;
+			}
+
+			virtual Fault store(ThreadContext & thread, uint64_t value) override {
+				this->_storeUnchecked(thread, MemoryArgument::SIZE, value);
+				return Fault::None;
+			}
+		};
+
 		//! @brief Const argument
 		//!
 		//! @warning This is read only argument, writing will cause @ref WriteToConstRuntimeError
@@ -126,8 +222,9 @@ namespace Evm {
 			ConstArgument(uint64_t constValue) :
 				_constValue{ constValue }
 			{}
-			virtual uint64_t getValue(ThreadContext & thread) const override;
-			virtual void setValue(ThreadContext & thread, uint64_t value) override;
+			virtual Fault load(ThreadContext & thread, uint64_t & value) const override;
+			virtual Fault store(ThreadContext & thread, uint64_t value) override;
+			virtual bool constValue(uint64_t & value) const override;
 			virtual string label() const override;
 			virtual string printValue(ThreadContext & thread) const override;
 		private:
@@ -142,8 +239,9 @@ namespace Evm {
 			AddressArgument(uint32_t value) :
 				_value{ value }
 			{}
-			virtual uint64_t getValue(ThreadContext & thread) const override;
-			virtual void setValue(ThreadContext & thread, uint64_t value) override;
+			virtual Fault load(ThreadContext & thread, uint64_t & value) const override;
+			virtual Fault store(ThreadContext & thread, uint64_t value) override;
+			virtual bool constValue(uint64_t & value) const override;
 			virtual string label() const override;
 			virtual string printValue(ThreadContext & thread) const override;
 		private:
@@ -185,5 +283,13 @@ namespace Evm {
 		//!		As output - offset to a bit after last bit of the argument
 		//! @throw RuntimeError
 		ArgumentPtr getAddressArgument(const Utils::BitBuffer & programMemory, uint32_t & offset);
+
+		//! @brief Make memory argument without bounds check
+		//!
+		//! Factory method. Make memory argument for an access proven in range
+		//! @param registerIndex Index of the register with the address
+		//! @param size Access size in bytes (1, 2, 4 or 8)
+		//! @return The argument, nullptr if size is not valid
+		ArgumentPtr getUncheckedMemoryArgument(uint8_t registerIndex, uint64_t size);
 	}
 }
\ No newline at end of file
@@ -0,0 +1,68 @@
+//! @file	AsyncIo.cpp
+//! @author	agent
+//! @date	10.2026
+//! @brief	IoRequest definition and IAsyncIo factory
+#include "stdafx.h"
+#include "AsyncIo.h"
+#include "IoUringAsyncIo.h"
+#include "ThreadPoolAsyncIo.h"
+#include "Platform.h"
+
+namespace Evm {
+	namespace Utils {
+		void IoRequest::wait()
+		{
+			while (state.load(memory_order_acquire) != DONE) {
+				Platform::futexWait(state, PENDING);
+			}
+		}
+
+		void IoRequest::complete()
+		{
+			state.store(DONE, memory_order_release);
+			Platform::futexWakeAll(state);
+		}
+
+		void IoRequest::execute()
+		{
+			// a request is reused, nothing of its previous result must survive
+			transferred = 0;
+			failed = false;
+			error = nullptr;
+			try {
+				if (type == Type::Read) {
+					transferred = file->read(offset, data, size);
+				}
+				else {
+					failed = !file->write(offset, data, size);
+					transferred = failed ? 0 : size;
+				}
+			}
+			catch (...) {
+				error = current_exception();
+				failed = true;
+				transferred = 0;
+			}
+		}
+
+		AsyncIoPtr makeAsyncIo(AsyncIoPolicy policy, bool nativeHandles)
+		{
+			switch (policy) {
+			case AsyncIoPolicy::Auto: {
+				if (nativeHandles) {
+					AsyncIoPtr ring{ IoUringAsyncIo::tryCreate() };
+					if (ring) {
+						return ring;
+					}
+				}
+				return make_unique<ThreadPoolAsyncIo>();
+			}
+			case AsyncIoPolicy::Threads:
+				return make_unique<ThreadPoolAsyncIo>();
+			case AsyncIoPolicy::Off:
+			default:
+				return nullptr;
+			}
+		}
+	}
+}
@@ -0,0 +1,114 @@
+//! @file	AsyncIo.h
+//! @author	agent
+//! @date	10.2026
+//! @brief	IAsyncIo interface
+//!
+//! IAsyncIo executes read and write instructions of user files asynchronously, so
+//! that only the issuing evm thread waits for the transfer. Each evm thread has a single
+//! IoRequest. The thread yields and other evm threads run on the round-robin scheduler
+//! thread meanwhile. Requests of many threads are submitted in batches, the scheduler
+//! queues them and submits them once per round. Threads that run on their own system
+//! threads don't use the backends, they would block their system threads in any case.
+//! The application selects a backend with @ref AsyncIoPolicy: io_uring (@ref IoUringAsyncIo)
+//! when the kernel supports it and the files have native handles, a small pool of
+//! system threads (@ref ThreadPoolAsyncIo) otherwise.
+#pragma once
+
+#include "stdafx.h"
+#include "InputFile.h"
+
+namespace Evm {
+	namespace Utils {
+		//! @brief Asynchronous I/O backend selector
+		enum class AsyncIoPolicy {
+			Off,		//!< Transfers are done by the issuing thread
+			Auto,		//!< io_uring if available, thread pool otherwise
+			Threads		//!< Thread pool
+		};
+
+		//! @brief Asynchronous transfer of a user file
+		struct IoRequest {
+			static constexpr uint32_t IDLE = 0;		//!< The request is not used
+			static constexpr uint32_t PENDING = 1;	//!< Submitted, not done yet
+			static constexpr uint32_t DONE = 2;		//!< Done, the result is valid
+
+			//! @brief Transfer direction
+			enum class Type : uint8_t {
+				Read,		//!< File -> data
+				Write		//!< data -> file
+			};
+
+			IFile * file = nullptr;		//!< The file
+			Type type = Type::Read;		//!< Transfer direction
+			uint64_t offset = 0;		//!< Offset in the file
+			Byte * data = nullptr;		//!< Buffer, only read by writes
+			uint64_t size = 0;			//!< Number of bytes
+			uint64_t transferred = 0;	//!< Number of transferred bytes
+			bool failed = false;		//!< True if the transfer has failed, the issuing thread reports it
+			exception_ptr error;		//!< Error thrown by the file, rethrown by the issuing thread
+			atomic<uint32_t> state{ IDLE };	//!< IDLE, PENDING or DONE, futex word
+
+			//! @brief Wait until the request is done
+			//! @note Blocking function
+			void wait();
+
+			//! @brief Mark the request done and wake up the waiter
+			//!
+			//! Called by backends, the request must not be touched afterwards
+			void complete();
+
+			//! @brief Execute the request with blocking calls of the file
+			//!
+			//! Errors thrown by the file are stored in @ref error, backends run it on their own threads
+			void execute();
+		};
+
+		//! @brief Asynchronous I/O statistics
+		struct AsyncIoStatistics {
+			uint64_t requests = 0;		//!< Number of submitted requests
+			uint64_t batches = 0;		//!< Number of submission system calls or worker wake-ups
+		};
+
+		//! @brief Asynchronous I/O backend interface
+		struct IAsyncIo {
+			virtual ~IAsyncIo() = default;
+
+			//! @brief Start a request
+			//!
+			//! The request must be in PENDING state and must exist until it is DONE.
+			//! @note Non-blocking function
+			//! @param request The request
+			virtual void submit(IoRequest & request) = 0;
+
+			//! @brief Add a request to the next batch
+			//!
+			//! Like submit(), but the request may wait until submitQueued() is called.
+			//! Used by the round-robin scheduler, which submits requests of all its threads at once.
+			//! @param request The request
+			virtual void queue(IoRequest & request) = 0;
+
+			//! @brief Submit queued requests
+			//! @note Non-blocking function
+			virtual void submitQueued() = 0;
+
+			//! @brief Get name of the backend
+			virtual const char * name() const = 0;
+
+			//! @brief Get backend statistics
+			virtual AsyncIoStatistics statistics() = 0;
+
+			IAsyncIo() = default;
+			IAsyncIo(const IAsyncIo &) = delete;
+			IAsyncIo & operator=(const IAsyncIo &) = delete;
+		};
+
+		using AsyncIoPtr = unique_ptr<IAsyncIo>;
+
+		//! @brief Create asynchronous I/O backend
+		//!
+		//! @param policy Backend selector
+		//! @param nativeHandles True if all user files have native handles, see IFile::nativeHandle()
+		//! @return The backend, nullptr for AsyncIoPolicy::Off
+		AsyncIoPtr makeAsyncIo(AsyncIoPolicy policy, bool nativeHandles);
+	}
+}
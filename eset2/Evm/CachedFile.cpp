@@ -0,0 +1,201 @@
+//! @file	CachedFile.cpp
+//! @author	agent
+//! @date	10.2026
+//! @brief	CachedFile class definition
+#include "stdafx.h"
+#include "CachedFile.h"
+
+namespace Evm {
+	namespace Utils {
+		CachedFile::CachedFile(FilePtr file, uint64_t dirtyLimit) :
+			_file{ move(file) },
+			_dirtyLimit{ dirtyLimit },
+			_flusher{ [this]() { _flushOnTime(); } }
+		{}
+
+		CachedFile::~CachedFile()
+		{
+			{
+				lock_guard<mutex> lock(_guard);
+				_isStopping = true;
+				_dirtied.notify_all();
+			}
+			_flusher.join();
+
+			lock_guard<mutex> lock(_guard);
+			_flush();
+		}
+
+		uint64_t CachedFile::read(uint64_t offset, Byte * data, uint64_t size)
+		{
+			size = min(size, numeric_limits<uint64_t>::max() - offset);
+
+			unique_lock<mutex> lock(_guard);
+			auto first = _pages.lower_bound(offset / PAGE_SIZE);
+			bool isBuffered = first != _pages.end() && first->first * PAGE_SIZE < offset + size;
+			uint64_t bufferedEnd = _pages.empty() ? 0 : _end;
+			if (!isBuffered) {
+				// no dirty byte in the range, other threads use the cache while the file is read
+				lock.unlock();
+			}
+			// otherwise the lock is held while the file is read, a flush in between would hide written data
+			uint64_t bytesRead = _file->read(offset, data, size);
+			if (bufferedEnd <= offset) {
+				return bytesRead;
+			}
+
+			// buffered writes beyond the end of the file, the gap reads as zeros
+			uint64_t res = max(bytesRead, min(size, bufferedEnd - offset));
+			memset(data + bytesRead, 0, static_cast<size_t>(res - bytesRead));
+			if (!isBuffered) {
+				return res;
+			}
+
+			uint64_t end = offset + res;
+			for (auto it = first; it != _pages.end() && it->first * PAGE_SIZE < end; ++it) {
+				uint64_t pageBegin = it->first * PAGE_SIZE;
+				uint64_t begin = max(offset, pageBegin) - pageBegin;
+				uint64_t stop = min(end - pageBegin, static_cast<uint64_t>(PAGE_SIZE));
+				const auto & page = it->second;
+				for (uint64_t i = begin; i < stop; i++) {
+					if (page.dirty[i]) {
+						data[pageBegin + i - offset] = page.data[i];
+					}
+				}
+			}
+			return res;
+		}
+
+		bool CachedFile::write(uint64_t offset, const Byte * data, uint64_t size)
+		{
+			if (size > numeric_limits<uint64_t>::max() - offset) {
+				return false;
+			}
+
+			lock_guard<mutex> lock(_guard);
+			if (size >= _dirtyLimit) {
+				// buffered data go first, they may overlap
+				return _flush() && _file->write(offset, data, size);
+			}
+
+			if (_pages.empty()) {
+				_oldest = Clock::now();
+				_dirtied.notify_one();
+			}
+			uint64_t done = 0;
+			while (done < size) {
+				uint64_t position = offset + done;
+				auto & page = _pages[position / PAGE_SIZE];
+				uint64_t begin = position % PAGE_SIZE;
+				uint64_t count = min(size - done, PAGE_SIZE - begin);
+				memcpy(page.data.data() + begin, data + done, static_cast<size_t>(count));
+				for (uint64_t i = begin; i < begin + count; i++) {
+					if (!page.dirty[i]) {
+						page.dirty.set(i);
+						_dirtyBytes++;
+					}
+				}
+				done += count;
+			}
+			_end = max(_end, offset + size);
+
+			if (_dirtyBytes >= _dirtyLimit) {
+				return _flush();
+			}
+			return true;
+		}
+
+		bool CachedFile::flush()
+		{
+			lock_guard<mutex> lock(_guard);
+			bool res = _flush();
+			return _file->flush() && res;
+		}
+
+		uint64_t CachedFile::size()
+		{
+			lock_guard<mutex> lock(_guard);
+			uint64_t res = _file->size();
+			return _pages.empty() ? res : max(res, _end);
+		}
+
+		bool CachedFile::_flush()
+		{
+			bool res = true;
+			Bytes run;
+			uint64_t runOffset = 0;
+			vector<pair<uint64_t, uint64_t>> written;	// offset and size of written runs
+			auto writeRun = [&]() {
+				if (run.empty()) {
+					return;
+				}
+				if (_file->write(runOffset, run.data(), run.size())) {
+					written.emplace_back(runOffset, run.size());
+				}
+				else {
+					res = false;
+				}
+				run.clear();
+			};
+
+			for (const auto & entry : _pages) {
+				uint64_t pageBegin = entry.first * PAGE_SIZE;
+				const auto & page = entry.second;
+				for (uint64_t i = 0; i < PAGE_SIZE; i++) {
+					if (!page.dirty[i]) {
+						continue;
+					}
+					// a byte that doesn't continue the run starts a new one
+					if (runOffset + run.size() != pageBegin + i) {
+						writeRun();
+						runOffset = pageBegin + i;
+					}
+					run.push_back(page.data[i]);
+				}
+			}
+			writeRun();
+
+			if (res) {
+				_pages.clear();
+				_dirtyBytes = 0;
+				_end = 0;
+				return true;
+			}
+
+			// keep the bytes of failed runs dirty
+			for (const auto & w : written) {
+				for (uint64_t position = w.first; position < w.first + w.second; position++) {
+					auto it = _pages.find(position / PAGE_SIZE);
+					it->second.dirty.reset(position % PAGE_SIZE);
+					_dirtyBytes--;
+					if (it->second.dirty.none()) {
+						_pages.erase(it);
+					}
+				}
+			}
+			if (_pages.empty()) {
+				_end = 0;
+			}
+			_oldest = Clock::now();
+			return false;
+		}
+
+		void CachedFile::_flushOnTime()
+		{
+			auto interval = chrono::milliseconds(static_cast<int64_t>(FLUSH_INTERVAL_MS));
+			unique_lock<mutex> lock(_guard);
+			while (!_isStopping) {
+				if (_pages.empty()) {
+					_dirtied.wait(lock);
+				}
+				else if (Clock::now() - _oldest >= interval) {
+					// a failed flush is retried after the interval, the error is reported by flush()
+					_flush();
+				}
+				else {
+					_dirtied.wait_until(lock, _oldest + interval);
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,86 @@
+//! @file	CachedFile.h
+//! @author	agent
+//! @date	10.2026
+//! @brief	CachedFile class declaration
+//!
+//! CachedFile is a write-back cache in front of another IFile. Written bytes are kept
+//! in page sized buffers, keyed by page index, each page has a mask of dirty bytes.
+//! The cache is flushed when the amount of dirty data reaches a limit, when the oldest
+//! dirty data is older than FLUSH_INTERVAL_MS (by a flusher thread) and at exit. A flush
+//! walks the pages in offset order and merges adjacent dirty bytes into runs, each run
+//! is a single write of the underlying file, so small writes at neighbouring offsets
+//! become one system call. Bytes of a failed write stay dirty, the next flush retries them.
+//! Reads see buffered data: the underlying file is read and dirty bytes are copied
+//! over the result, the file is logically extended by buffered writes beyond its end.
+//! A single mutex protects the cache. A read that doesn't overlap dirty bytes releases it
+//! before the underlying file is read, other operations are serialized.
+//! Writes larger than the limit bypass the cache.
+#pragma once
+
+#include "stdafx.h"
+#include "InputFile.h"
+
+namespace Evm {
+	namespace Utils {
+		//! @brief Write-back cache of a file
+		struct CachedFile : IFile {
+			static constexpr uint64_t PAGE_SIZE = 4096;			//!< Size of a cache page
+			static constexpr uint64_t FLUSH_INTERVAL_MS = 100;	//!< The longest time data stay dirty
+
+			//! @brief Constructor
+			//!
+			//! @param file The cached file
+			//! @param dirtyLimit Number of dirty bytes that triggers flush
+			CachedFile(FilePtr file, uint64_t dirtyLimit);
+
+			//! @brief Destructor
+			//!
+			//! Stop the flusher and flush the cache, errors are ignored
+			~CachedFile() override;
+
+			uint64_t read(uint64_t offset, Byte * data, uint64_t size) override;
+
+			bool write(uint64_t offset, const Byte * data, uint64_t size) override;
+
+			//! @brief Flush the cache and the underlying file
+			bool flush() override;
+
+			//! @brief Size of the file, extended by buffered writes beyond its end
+			uint64_t size() override;
+
+			const string & name() const override {
+				return _file->name();
+			}
+
+		private:
+			using Clock = chrono::steady_clock;
+
+			//! Cache page
+			struct Page {
+				array<Byte, PAGE_SIZE> data;	//!< Content, valid where dirty
+				bitset<PAGE_SIZE> dirty;		//!< Mask of written bytes
+			};
+
+			FilePtr _file;					//!< The cached file
+			uint64_t _dirtyLimit;			//!< Flush threshold in bytes
+			mutex _guard;					//!< Protects the cache
+			map<uint64_t, Page> _pages;		//!< Page index -> page with dirty bytes
+			uint64_t _dirtyBytes = 0;		//!< Number of dirty bytes in all pages
+			uint64_t _end = 0;				//!< The greatest end of buffered writes
+			Clock::time_point _oldest;		//!< Time of the first write after flush
+			bool _isStopping = false;		//!< True when the flusher should exit
+			condition_variable _dirtied;	//!< Signaled when the cache gets dirty or is stopping
+			thread _flusher;				//!< Flushes data older than FLUSH_INTERVAL_MS
+
+			//! @brief Helper function. Write dirty runs to the file
+			//!
+			//! Written bytes are removed from the cache, bytes of failed runs stay dirty.
+			//! @note Call it with _guard locked
+			//! @return True on success
+			bool _flush();
+
+			//! @brief Helper function. Flusher thread loop
+			void _flushOnTime();
+		};
+	}
+}
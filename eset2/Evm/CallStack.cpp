@@ -0,0 +1,40 @@
+//! @file	CallStack.cpp
+//! @author	agent
+//! @date	10.2026
+//! @brief	CallStack class definition
+#include "stdafx.h"
+#include "CallStack.h"
+
+namespace Evm {
+	namespace Utils {
+		void CallStack::clear()
+		{
+			_size = 0;
+			_peakDepth = 0;
+		}
+
+		void CallStack::maxDepth(size_t maxDepth)
+		{
+			_maxDepth = maxDepth;
+			if (_data == _inline.data()) {
+				// push() checks the limit only when the storage is full
+				_capacity = (maxDepth < INLINE_CAPACITY) ? maxDepth : static_cast<size_t>(INLINE_CAPACITY);
+			}
+		}
+
+		bool CallStack::_grow()
+		{
+			if (_size >= _maxDepth) {
+				return false;
+			}
+
+			size_t newCapacity = min(max<size_t>(_capacity * 2, 1), _maxDepth);
+			unique_ptr<uint32_t[]> newHeap{ new uint32_t[newCapacity] };
+			copy(_data, _data + _size, newHeap.get());
+			_heap = move(newHeap);
+			_data = _heap.get();
+			_capacity = newCapacity;
+			return true;
+		}
+	}
+}
@@ -0,0 +1,92 @@
+//! @file	CallStack.h
+//! @author	agent
+//! @date	10.2026
+//! @brief	CallStack class declaration
+//!
+//! CallStack keeps return addresses of call instructions. Usual evm programs
+//! don't nest calls deeply, so the first entries are stored inline, in the thread
+//! state. Deeper stacks move to a heap buffer that grows geometrically and is kept
+//! when the stack is cleared, so recycled threads don't allocate again. The depth
+//! is limited. push() and pop() don't throw, they report overflow and underflow
+//! with the return value.
+#pragma once
+
+#include "stdafx.h"
+
+namespace Evm {
+	namespace Utils {
+		//! @brief Return address stack with inline storage and depth limit
+		struct CallStack {
+			static constexpr size_t INLINE_CAPACITY = 16;		//!< Entries stored without allocation
+			static constexpr size_t DEFAULT_MAX_DEPTH = 65536;	//!< Default depth limit
+
+			CallStack() = default;
+			CallStack(const CallStack &) = delete;
+			CallStack & operator=(const CallStack &) = delete;
+
+			//! @brief Push return address
+			//!
+			//! @param address Return address
+			//! @return False if the depth limit is reached
+			bool push(uint32_t address) {
+				if (_size == _capacity && !_grow()) {
+					return false;
+				}
+				_data[_size++] = address;
+				if (_size > _peakDepth) {
+					_peakDepth = _size;
+				}
+				return true;
+			}
+
+			//! @brief Pop return address
+			//!
+			//! @param address Output, address from the top of the stack
+			//! @return False if the stack is empty
+			bool pop(uint32_t & address) {
+				if (_size == 0) {
+					return false;
+				}
+				address = _data[--_size];
+				return true;
+			}
+
+			//! @brief Remove all entries
+			//!
+			//! Storage is kept for reuse, the peak depth is reset
+			void clear();
+
+			//! @brief Set depth limit
+			//! @param maxDepth Maximum number of entries
+			void maxDepth(size_t maxDepth);
+
+			//! @brief Get depth limit
+			size_t maxDepth() const {
+				return _maxDepth;
+			}
+
+			//! @brief Get current depth
+			size_t size() const {
+				return _size;
+			}
+
+			//! @brief Get the greatest depth since construction or clear()
+			size_t peakDepth() const {
+				return _peakDepth;
+			}
+
+		private:
+			array<uint32_t, INLINE_CAPACITY> _inline;	//!< Inline storage
+			unique_ptr<uint32_t[]> _heap;				//!< Heap storage when inline storage is too small
+			uint32_t * _data = _inline.data();			//!< Current storage
+			size_t _size = 0;							//!< Number of entries
+			size_t _capacity = INLINE_CAPACITY;			//!< Capacity of current storage
+			size_t _maxDepth = DEFAULT_MAX_DEPTH;		//!< Depth limit
+			size_t _peakDepth = 0;						//!< The greatest depth
+
+			//! @brief Helper function. Slow path of push(), grow the storage
+			//! @return False if the depth limit is reached
+			bool _grow();
+		};
+	}
+}
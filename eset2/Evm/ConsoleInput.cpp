@@ -0,0 +1,126 @@
+//! @file	ConsoleInput.cpp
+//! @author	agent
+//! @date	10.2026
+//! @brief	ConsoleInput class definition
+#include "stdafx.h"
+#include "ConsoleInput.h"
+#include "Platform.h"
+
+namespace Evm {
+	namespace Utils {
+		ConsoleInput::ConsoleInput(ConsoleOutput & output) :
+			_output{ output }
+		{}
+
+		uint64_t ConsoleInput::read()
+		{
+			lock_guard<mutex> lock(_guard);
+			while (_values.empty() && !_isExhausted) {
+				_fill();
+			}
+			if (_values.empty()) {
+				return 0;
+			}
+			uint64_t value = _values.front();
+			_values.pop_front();
+			return value;
+		}
+
+		uint64_t ConsoleInput::values() const
+		{
+			lock_guard<mutex> lock(_guard);
+			return _parsed;
+		}
+
+		uint64_t ConsoleInput::reads() const
+		{
+			lock_guard<mutex> lock(_guard);
+			return _reads;
+		}
+
+		void ConsoleInput::_fill()
+		{
+			_output.flush();
+
+			size_t offset = _text.size();
+			_text.resize(offset + CHUNK_SIZE);
+			size_t read = 0;
+			bool isRead = Platform::readStandardInput(&_text[offset], CHUNK_SIZE, read);
+			_text.resize(offset + read);
+			_reads++;
+
+			// a read error ends the input as well
+			_parse(!isRead || read == 0);
+		}
+
+		void ConsoleInput::_parse(bool isFinal)
+		{
+			const uint64_t maxValue = numeric_limits<uint64_t>::max();
+			const char * text = _text.data();
+			size_t size = _text.size();
+			size_t pos = 0;
+
+			while (!_isExhausted) {
+				while (pos < size && isspace(static_cast<unsigned char>(text[pos]))) {
+					pos++;
+				}
+				if (pos == size) {
+					if (isFinal) {
+						_isExhausted = true;
+					}
+					break;
+				}
+
+				size_t begin = pos;
+				bool isNegative = (text[pos] == '-');
+				if (text[pos] == '-' || text[pos] == '+') {
+					pos++;
+				}
+				bool hasPrefix = pos + 1 < size && text[pos] == '0' && (text[pos + 1] == 'x' || text[pos + 1] == 'X');
+				if (hasPrefix) {
+					pos += 2;
+				}
+				size_t digits = pos;
+				uint64_t value = 0;
+				bool isOverflow = false;
+				int digit;
+				while (pos < size && (digit = _digit(text[pos])) >= 0) {
+					isOverflow = isOverflow || (value >> 60) != 0;
+					value = (value << 4) | static_cast<uint64_t>(digit);
+					pos++;
+				}
+
+				// the token may continue in the next chunk
+				if (pos == size && !isFinal) {
+					pos = begin;
+					break;
+				}
+
+				if (pos == digits || isOverflow) {
+					// no digits, or the value doesn't fit
+					_values.push_back(isOverflow ? maxValue : 0);
+					_isExhausted = true;
+				}
+				else {
+					_values.push_back(isNegative ? 0 - value : value);
+					_parsed++;
+				}
+			}
+			_text.erase(0, pos);
+		}
+
+		int ConsoleInput::_digit(char c)
+		{
+			if (c >= '0' && c <= '9') {
+				return c - '0';
+			}
+			if (c >= 'a' && c <= 'f') {
+				return c - 'a' + 10;
+			}
+			if (c >= 'A' && c <= 'F') {
+				return c - 'A' + 10;
+			}
+			return -1;
+		}
+	}
+}
@@ -0,0 +1,71 @@
+//! @file	ConsoleInput.h
+//! @author	agent
+//! @date	10.2026
+//! @brief	ConsoleInput class declaration
+//!
+//! ConsoleInput is the source of consoleRead. The standard input is read in large chunks,
+//! all complete hex tokens of a chunk are parsed at once to a queue and consoleRead
+//! instructions of all evm threads take values from it. A token is split between chunks
+//! only if it reaches the end of a chunk, then its beginning is kept for the next one.
+//! Tokens are parsed like cin >> hex: leading white space is skipped, a sign and 0x prefix
+//! are optional and the token ends at the first character that is not a hex digit.
+//! Errors of cin are defined here:
+//! - a token without digits gives 0, an overflowing token gives the maximal value,
+//! - after such a token or at the end of input every read gives 0.
+//! Like cin tied to cout, the console output is flushed before the standard input is read,
+//! so a prompt is visible when the program waits for input.
+#pragma once
+
+#include "stdafx.h"
+#include "ConsoleOutput.h"
+
+namespace Evm {
+	namespace Utils {
+		//! @brief Console input source
+		struct ConsoleInput {
+			static constexpr size_t CHUNK_SIZE = 64 * 1024;		//!< Bytes of a single read of standard input
+
+			//! @brief Constructor
+			//!
+			//! @param output Console output flushed before each read of standard input
+			ConsoleInput(ConsoleOutput & output);
+
+			//! @brief Get the next value
+			//!
+			//! Standard input is read only when the queue is empty
+			//! @note Blocking function
+			//! @return The value, 0 if the input is exhausted
+			uint64_t read();
+
+			//! @brief Get number of valid parsed values
+			uint64_t values() const;
+
+			//! @brief Get number of reads of standard input
+			uint64_t reads() const;
+
+			ConsoleInput(const ConsoleInput &) = delete;
+			ConsoleInput & operator=(const ConsoleInput &) = delete;
+
+		private:
+			ConsoleOutput & _output;	//!< Tied console output
+			mutable mutex _guard;		//!< Protects all members
+			deque<uint64_t> _values;	//!< Parsed values, not read yet
+			string _text;				//!< Unparsed input, the beginning of a split token
+			bool _isExhausted = false;	//!< True after the end of input or an invalid token
+			uint64_t _parsed = 0;		//!< Number of parsed values
+			uint64_t _reads = 0;		//!< Number of reads of standard input
+
+			//! @brief Helper function. Read a chunk and parse it
+			void _fill();
+
+			//! @brief Helper function. Parse complete tokens of _text
+			//!
+			//! @param isFinal True if no more input follows _text
+			void _parse(bool isFinal);
+
+			//! @brief Helper function. Value of a hex digit
+			//! @return The value, -1 if the character is not a hex digit
+			static int _digit(char c);
+		};
+	}
+}
@@ -0,0 +1,147 @@
+//! @file	ConsoleOutput.cpp
+//! @author	agent
+//! @date	10.2026
+//! @brief	ConsoleOutput class definition
+#include "stdafx.h"
+#include "ConsoleOutput.h"
+#include "Platform.h"
+
+namespace Evm {
+	namespace Utils {
+		ConsoleOutput::ConsoleOutput(bool lineBuffered) :
+			_lineBuffered{ lineBuffered }
+		{
+			if (!_lineBuffered) {
+				_flusher = thread{ [this]() { _flushOnTime(); } };
+			}
+		}
+
+		ConsoleOutput::~ConsoleOutput()
+		{
+			if (_flusher.joinable()) {
+				{
+					lock_guard<mutex> lock(_timerGuard);
+					_isStopping = true;
+					_dirtied.notify_all();
+				}
+				_flusher.join();
+			}
+			flush();
+		}
+
+		ConsoleOutput::Buffer * ConsoleOutput::acquire()
+		{
+			lock_guard<mutex> lock(_buffersGuard);
+			if (!_freeBuffers.empty()) {
+				Buffer * buffer = _freeBuffers.back();
+				_freeBuffers.pop_back();
+				return buffer;
+			}
+			_buffers.push_back(make_unique<Buffer>());
+			return _buffers.back().get();
+		}
+
+		void ConsoleOutput::release(Buffer * buffer)
+		{
+			lock_guard<mutex> lock(_buffersGuard);
+			_freeBuffers.push_back(buffer);
+		}
+
+		void ConsoleOutput::write(Buffer & buffer, uint64_t value)
+		{
+			bool isFull;
+			{
+				// the number is taken under the buffer lock, flush relies on it
+				lock_guard<mutex> lock(buffer.guard);
+				buffer.lines.emplace_back();
+				auto & line = buffer.lines.back();
+				// sequentially consistent with _isDirty, a line is either below the limit
+				// of the timed flush or it dirties the output again
+				line.sequence = _nextSequence.fetch_add(1);
+				_format(value, line.text);
+				isFull = buffer.lines.size() >= BUFFER_LINES;
+			}
+			if (_lineBuffered || isFull) {
+				flush();
+			}
+			else if (!_isDirty.load()) {
+				lock_guard<mutex> lock(_timerGuard);
+				if (!_isDirty.load()) {
+					_oldest = Clock::now();
+					_isDirty.store(true);
+					_dirtied.notify_one();
+				}
+			}
+		}
+
+		bool ConsoleOutput::flush()
+		{
+			lock_guard<mutex> flushLock(_flushGuard);
+			uint64_t limit = _nextSequence.load();
+			{
+				lock_guard<mutex> lock(_buffersGuard);
+				for (auto & buffer : _buffers) {
+					lock_guard<mutex> bufferLock(buffer->guard);
+					auto & lines = buffer->lines;
+					auto end = find_if(lines.begin(), lines.end(), [limit](const Line & l) { return l.sequence >= limit; });
+					_pending.insert(_pending.end(), lines.begin(), end);
+					lines.erase(lines.begin(), end);
+				}
+			}
+			if (_pending.empty()) {
+				return true;
+			}
+
+			sort(_pending.begin(), _pending.end(), [](const Line & a, const Line & b) { return a.sequence < b.sequence; });
+			_text.clear();
+			for (const auto & line : _pending) {
+				_text.append(line.text.data(), line.text.size());
+			}
+			_pending.clear();
+			_flushes++;
+			return Platform::writeStandardOutput(_text.data(), _text.size());
+		}
+
+		uint64_t ConsoleOutput::lines() const
+		{
+			return _nextSequence.load();
+		}
+
+		uint64_t ConsoleOutput::flushes() const
+		{
+			return _flushes;
+		}
+
+		void ConsoleOutput::_format(uint64_t value, array<char, LINE_LENGTH> & text)
+		{
+			static const char DIGITS[] = "0123456789abcdef";
+			text[0] = '0';
+			text[1] = 'x';
+			for (size_t i = 0; i < 16; i++) {
+				text[17 - i] = DIGITS[(value >> (4 * i)) & 0xf];
+			}
+			text[18] = '\n';
+		}
+
+		void ConsoleOutput::_flushOnTime()
+		{
+			auto interval = chrono::milliseconds(static_cast<int64_t>(FLUSH_INTERVAL_MS));
+			unique_lock<mutex> lock(_timerGuard);
+			while (!_isStopping) {
+				if (!_isDirty.load()) {
+					_dirtied.wait(lock);
+				}
+				else if (Clock::now() - _oldest >= interval) {
+					// cleared first, a line written during the flush starts a new interval
+					_isDirty.store(false);
+					lock.unlock();
+					flush();
+					lock.lock();
+				}
+				else {
+					_dirtied.wait_until(lock, _oldest + interval);
+				}
+			}
+		}
+	}
+}
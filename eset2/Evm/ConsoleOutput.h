@@ -0,0 +1,105 @@
+//! @file	ConsoleOutput.h
+//! @author	agent
+//! @date	10.2026
+//! @brief	ConsoleOutput class declaration
+//!
+//! ConsoleOutput is the sink of consoleWrite. Each writing evm thread has its own buffer,
+//! a line is formatted into it with a table lookup, without iostreams and without a shared
+//! lock. Every line gets a global sequence number. A flush takes, from all buffers, the
+//! lines numbered below the counter value at the start of the flush - a line gets its
+//! number under the lock of its buffer, so these lines are all in the buffers - sorts
+//! them and writes them to the standard output with a single call. The output has the
+//! order in which consoleWrite instructions were executed, as with a global lock.
+//! A buffer is flushed when it is full, all buffers are flushed when the oldest unflushed
+//! line is FLUSH_INTERVAL_MS old (by a flusher thread) and at exit. In line buffered
+//! mode, the default for a terminal, each line is flushed at once.
+#pragma once
+
+#include "stdafx.h"
+
+namespace Evm {
+	namespace Utils {
+		//! @brief Console output sink
+		struct ConsoleOutput {
+			static constexpr size_t LINE_LENGTH = 19;		//!< "0x" + 16 hex digits + new line
+			static constexpr size_t BUFFER_LINES = 1024;	//!< Lines of a buffer that trigger flush
+			static constexpr uint64_t FLUSH_INTERVAL_MS = 100;	//!< The longest time a line stays buffered
+
+			//! @brief Formatted line
+			struct Line {
+				uint64_t sequence;					//!< Global order of the line
+				array<char, LINE_LENGTH> text;		//!< The line
+			};
+
+			//! @brief Per thread buffer
+			struct Buffer {
+				mutex guard;			//!< Taken by the owner and by flushes, contended only by flushes
+				vector<Line> lines;		//!< Lines in sequence order
+			};
+
+			//! @brief Constructor
+			//!
+			//! @param lineBuffered True if each line is flushed at once
+			ConsoleOutput(bool lineBuffered);
+
+			//! @brief Destructor
+			//!
+			//! Stop the flusher thread and flush all buffers
+			~ConsoleOutput();
+
+			//! @brief Get a buffer for an evm thread
+			//!
+			//! Buffers are reused, lines left in a released buffer are still flushed
+			//! @return The buffer
+			Buffer * acquire();
+
+			//! @brief Return a buffer taken with acquire()
+			void release(Buffer * buffer);
+
+			//! @brief Write a value as a hex line
+			//!
+			//! @param buffer Buffer of the calling thread
+			//! @param value The value
+			void write(Buffer & buffer, uint64_t value);
+
+			//! @brief Write buffered lines to the standard output
+			//!
+			//! @return False if the standard output can't be written
+			bool flush();
+
+			//! @brief Get number of written lines
+			uint64_t lines() const;
+
+			//! @brief Get number of flushes that have written something
+			uint64_t flushes() const;
+
+			ConsoleOutput(const ConsoleOutput &) = delete;
+			ConsoleOutput & operator=(const ConsoleOutput &) = delete;
+
+		private:
+			using Clock = chrono::steady_clock;
+
+			const bool _lineBuffered;				//!< Flush after each line
+			atomic<uint64_t> _nextSequence{ 0 };	//!< Sequence number of the next line
+			mutex _buffersGuard;					//!< Protects _buffers and _freeBuffers
+			vector<unique_ptr<Buffer>> _buffers;	//!< All buffers
+			vector<Buffer *> _freeBuffers;			//!< Released buffers
+			mutex _flushGuard;						//!< Serializes flushes, so they are written in order
+			vector<Line> _pending;					//!< Lines of the current flush
+			string _text;							//!< Text of the current flush
+			uint64_t _flushes = 0;					//!< Number of flushes that have written something
+			mutex _timerGuard;						//!< Protects _oldest and _isStopping, sets _isDirty
+			atomic<bool> _isDirty{ false };			//!< True if a line was written after the timed flush
+			Clock::time_point _oldest;				//!< Time of the first line after the timed flush
+			bool _isStopping = false;				//!< True when the flusher should exit
+			condition_variable _dirtied;			//!< Signaled when a line is buffered or on stopping
+			thread _flusher;						//!< Flushes lines older than FLUSH_INTERVAL_MS, batched mode only
+
+			//! @brief Helper function. Format a line
+			static void _format(uint64_t value, array<char, LINE_LENGTH> & text);
+
+			//! @brief Helper function. Flusher thread loop
+			void _flushOnTime();
+		};
+	}
+}
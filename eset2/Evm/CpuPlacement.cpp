@@ -0,0 +1,162 @@
+//! @file	CpuPlacement.cpp
+//! @author	agent
+//! @date	10.2026
+//! @brief	CpuPlacement class definition
+#include "stdafx.h"
+#include "CpuPlacement.h"
+#include "Platform.h"
+#include "RuntimeError.h"
+
+namespace Evm {
+	namespace Utils {
+		vector<uint32_t> parseCpuSet(const string & text)
+		{
+			vector<uint32_t> res;
+			istringstream iss{ text };
+			string item;
+			while (getline(iss, item, ',')) {
+				uint32_t first = 0;
+				uint32_t last = 0;
+				char dash = 0;
+				istringstream itemStream{ item };
+				if (!(itemStream >> first)) {
+					throw CliConfigurationRuntimeError{ "Bad CPU set: " + text };
+				}
+				last = first;
+				if (itemStream >> dash && (dash != '-' || !(itemStream >> last) || last < first)) {
+					throw CliConfigurationRuntimeError{ "Bad CPU set: " + text };
+				}
+				for (uint32_t cpu = first; cpu <= last; cpu++) {
+					if (find(begin(res), end(res), cpu) == end(res)) {
+						res.push_back(cpu);
+					}
+				}
+			}
+			return res;
+		}
+
+		CpuPlacement::CpuPlacement(AffinityPolicy policy, const vector<uint32_t> & cpuSet) :
+			_policy{ policy }
+		{
+			if (_policy == AffinityPolicy::None && cpuSet.empty()) {
+				return;
+			}
+
+			// processors of the set that the process may use, in the order of the set
+			auto available = Platform::availableCpus();
+			vector<Platform::CpuInfo> cpus;
+			if (cpuSet.empty()) {
+				cpus = available;
+			}
+			for (auto id : cpuSet) {
+				auto it = find_if(begin(available), end(available), [id](const Platform::CpuInfo & c) { return c.id == id; });
+				if (it != end(available)) {
+					cpus.push_back(*it);
+				}
+			}
+			if (cpus.empty()) {
+				throw CliConfigurationRuntimeError{ "CPU set doesn't contain any available processor" };
+			}
+
+			// index of hyperthread within its core and of core within its package
+			map<pair<uint32_t, uint32_t>, uint32_t> threadsPerCore;
+			map<uint32_t, map<uint32_t, uint32_t>> coreIndex;
+			using Key = tuple<uint32_t, uint32_t, uint32_t, uint32_t>;	// hyperthread, core index, package, id
+			vector<Key> keys;
+			for (const auto & c : cpus) {
+				uint32_t sibling = threadsPerCore[make_pair(c.package, c.core)]++;
+				auto & cores = coreIndex[c.package];
+				if (cores.find(c.core) == end(cores)) {
+					uint32_t index = static_cast<uint32_t>(cores.size());
+					cores[c.core] = index;
+				}
+				keys.emplace_back(sibling, cores[c.core], c.package, c.id);
+			}
+
+			switch (_policy) {
+			case AffinityPolicy::Compact:
+				// package, core, hyperthread
+				sort(begin(keys), end(keys), [](const Key & a, const Key & b) {
+					return make_tuple(get<2>(a), get<1>(a), get<0>(a)) < make_tuple(get<2>(b), get<1>(b), get<0>(b));
+				});
+				break;
+			case AffinityPolicy::Spread:
+				// first hyperthreads of all cores, cores of packages interleaved
+				sort(begin(keys), end(keys));
+				break;
+			default:
+				break;
+			}
+			for (const auto & k : keys) {
+				_order.push_back(get<3>(k));
+			}
+		}
+
+		bool CpuPlacement::isEnabled() const
+		{
+			return !_order.empty();
+		}
+
+		void CpuPlacement::pinCurrentThread()
+		{
+			if (_order.empty()) {
+				return;
+			}
+
+			vector<uint32_t> cpus;
+			if (_policy == AffinityPolicy::None) {
+				// restrict to the set only, the system places the thread
+				cpus = _order;
+			}
+			else {
+				uint64_t slot = _nextSlot.fetch_add(1);
+				cpus.push_back(_order[slot % _order.size()]);
+			}
+			bool pinned = Platform::setThreadAffinity(cpus);
+
+			lock_guard<mutex> guard(_guard);
+			if (!pinned) {
+				_pinFailures++;
+			}
+			else if (cpus.size() == 1) {
+				_records[static_cast<int32_t>(cpus.front())].pinned++;
+			}
+		}
+
+		void CpuPlacement::recordThread(int32_t startCpu, int32_t endCpu)
+		{
+			lock_guard<mutex> guard(_guard);
+			_records[startCpu].started++;
+			_records[endCpu].finished++;
+			if (startCpu != endCpu) {
+				_migrated++;
+			}
+		}
+
+		void CpuPlacement::printReport(ostream & os)
+		{
+			static const array<const char *, 4> POLICY_NAMES{ "none", "compact", "spread", "round-robin" };
+
+			lock_guard<mutex> guard(_guard);
+			os << "\tplacement (" << POLICY_NAMES[static_cast<size_t>(_policy)] << "): order";
+			if (_order.empty()) {
+				os << " -";
+			}
+			for (auto cpu : _order) {
+				os << " " << cpu;
+			}
+			os << ", migrated threads " << _migrated << ", affinity failures " << _pinFailures << "\n";
+			for (const auto & r : _records) {
+				os << "\t\tcpu ";
+				if (r.first < 0) {
+					os << "?";
+				}
+				else {
+					os << r.first;
+				}
+				os << ": pinned " << r.second.pinned << ", started " << r.second.started <<
+					", finished " << r.second.finished << "\n";
+			}
+		}
+	}
+}
@@ -0,0 +1,80 @@
+//! @file	CpuPlacement.h
+//! @author	agent
+//! @date	10.2026
+//! @brief	CpuPlacement class declaration
+//!
+//! CpuPlacement pins system threads that execute evm threads (worker pool threads
+//! or the round-robin scheduler thread) to processors of a CPU set. Threads that
+//! migrate between cores move the cache lines of evm locks and data memory with them,
+//! pinning keeps them in place. The placement also records on which processors evm
+//! threads started and finished, so the effect can be checked.
+#pragma once
+
+#include "stdafx.h"
+
+namespace Evm {
+	namespace Utils {
+		//! @brief Thread placement policy
+		enum class AffinityPolicy {
+			None,			//!< Threads may run on any processor of the CPU set
+			Compact,		//!< Fill hyperthreads of a core, then next cores - threads share caches
+			Spread,			//!< One thread per physical core first, alternating packages
+			RoundRobin		//!< Processors of the CPU set in the given order
+		};
+
+		//! @brief Parse CPU set
+		//!
+		//! Format is a comma separated list of processor numbers and ranges, e.g. "0-3,6".
+		//! @param text The CPU set
+		//! @return Logical processor numbers in the given order
+		//! @throw CliConfigurationRuntimeError
+		vector<uint32_t> parseCpuSet(const string & text);
+
+		//! @brief Placement of system threads on processors
+		struct CpuPlacement {
+			//! @brief Constructor
+			//!
+			//! Orders processors of the CPU set according to the policy
+			//! @param policy Placement policy
+			//! @param cpuSet Allowed processors, all available processors if empty
+			//! @throw CliConfigurationRuntimeError
+			CpuPlacement(AffinityPolicy policy, const vector<uint32_t> & cpuSet);
+
+			//! @brief Check if threads are pinned
+			bool isEnabled() const;
+
+			//! @brief Pin the calling thread
+			//!
+			//! Consecutive calls take consecutive slots of the placement order.
+			//! @note Thread safe
+			void pinCurrentThread();
+
+			//! @brief Record where an evm thread ran
+			//!
+			//! @param startCpu Processor at the start of the thread, -1 if unknown
+			//! @param endCpu Processor at the end of the thread, -1 if unknown
+			//! @note Thread safe
+			void recordThread(int32_t startCpu, int32_t endCpu);
+
+			//! @brief Print placement report
+			//! @param os Output stream
+			void printReport(ostream & os);
+
+		private:
+			//! Per processor counters
+			struct CpuRecord {
+				uint64_t pinned = 0;		//!< System threads pinned to the processor
+				uint64_t started = 0;		//!< Evm threads started on the processor
+				uint64_t finished = 0;		//!< Evm threads finished on the processor
+			};
+
+			const AffinityPolicy _policy;		//!< Placement policy
+			vector<uint32_t> _order;			//!< Processors in placement order
+			atomic<uint64_t> _nextSlot{ 0 };	//!< Slot of the next pinned thread
+			mutex _guard;						//!< Protects the records
+			map<int32_t, CpuRecord> _records;	//!< Processor -> counters
+			uint64_t _migrated = 0;				//!< Evm threads that finished on other processor than started
+			uint64_t _pinFailures = 0;			//!< Failed affinity calls
+		};
+	}
+}
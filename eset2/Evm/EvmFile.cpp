@@ -46,7 +46,7 @@ namespace Evm {
 
 			evm->payload.swap(newPayload);
 
-			return move(evm);
+			return evm;
 		}
 
 		void validateEvm(const EvmFile & evm)
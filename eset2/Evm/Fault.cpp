@@ -0,0 +1,73 @@
+//! @file	Fault.cpp
+//! @author	agent
+//! @date	10.2026
+//! @brief	Fault codes of evm instructions
+#include "stdafx.h"
+#include "Fault.h"
+#include "RuntimeError.h"
+
+namespace Evm {
+	//! @brief Helper function. Details of a data memory fault
+	static string memoryAccessMessage(const char * access, const FaultRecord & record)
+	{
+		return string{ access } + " beyound memory. Memory size :" + to_string(record.limit) +
+			" address: " + to_string(record.address) + " size: " + to_string(record.size);
+	}
+
+	void throwFault(const FaultRecord & record)
+	{
+		switch (record.fault) {
+		case Fault::DataMemoryRead: {
+			string msg = memoryAccessMessage("Reading", record);
+			throw DataMemoryOutOfRangeRuntimeError{ msg };
+		}
+		case Fault::DataMemoryWrite: {
+			string msg = memoryAccessMessage("Writing", record);
+			throw DataMemoryOutOfRangeRuntimeError{ msg };
+		}
+		case Fault::ProgramMemory:
+			throw ProgramMemoryOutOfRangeRuntimeError{};
+		case Fault::WriteToConst:
+			throw WriteToConstRuntimeError{};
+		case Fault::StackUnderflow:
+			throw StackRuntimeError{};
+		case Fault::StackOverflow:
+			throw StackOverflowRuntimeError{ record.limit };
+		case Fault::FuelExhausted:
+			throw FuelExhaustedRuntimeError{ record.limit };
+		case Fault::RuntimeError:
+		case Fault::None:
+		default:
+			throw RuntimeError{ record.message };
+		}
+	}
+
+	string faultMessage(const FaultRecord & record)
+	{
+		// the errors are only constructed for their messages, the report path doesn't throw
+		switch (record.fault) {
+		case Fault::DataMemoryRead: {
+			string msg = memoryAccessMessage("Reading", record);
+			return DataMemoryOutOfRangeRuntimeError{ msg }.what();
+		}
+		case Fault::DataMemoryWrite: {
+			string msg = memoryAccessMessage("Writing", record);
+			return DataMemoryOutOfRangeRuntimeError{ msg }.what();
+		}
+		case Fault::ProgramMemory:
+			return ProgramMemoryOutOfRangeRuntimeError{}.what();
+		case Fault::WriteToConst:
+			return WriteToConstRuntimeError{}.what();
+		case Fault::StackUnderflow:
+			return StackRuntimeError{}.what();
+		case Fault::StackOverflow:
+			return StackOverflowRuntimeError{ record.limit }.what();
+		case Fault::FuelExhausted:
+			return FuelExhaustedRuntimeError{ record.limit }.what();
+		case Fault::RuntimeError:
+		case Fault::None:
+		default:
+			return record.message;
+		}
+	}
+}
@@ -0,0 +1,50 @@
+//! @file	Fault.h
+//! @author	agent
+//! @date	10.2026
+//! @brief	Fault codes of evm instructions
+//!
+//! Instructions on the fast path don't throw. A handler returns a Fault code and stores
+//! the details in the FaultRecord of the thread. The execution loop turns the record
+//! into a message only when it reports the error, so the common path has no exception
+//! handling and the failing one doesn't build strings it doesn't need.
+#pragma once
+
+#include "stdafx.h"
+
+namespace Evm {
+	//! @brief Fault code
+	enum class Fault : uint8_t {
+		None = 0,				//!< No fault
+		DataMemoryRead,			//!< Read beyond data memory: address, size, limit
+		DataMemoryWrite,		//!< Write beyond data memory: address, size, limit
+		ProgramMemory,			//!< Instruction beyond program memory
+		WriteToConst,			//!< Write to a read-only argument
+		StackUnderflow,			//!< ret with empty call stack
+		StackOverflow,			//!< Call stack deeper than limit
+		FuelExhausted,			//!< Instruction budget exhausted: limit
+		RuntimeError			//!< Other RuntimeError: message
+	};
+
+	//! @brief Fault details
+	struct FaultRecord {
+		Fault fault = Fault::None;	//!< Fault code
+		uint64_t address = 0;		//!< Faulting address
+		uint64_t size = 0;			//!< Size of faulting access
+		uint64_t limit = 0;			//!< Violated limit
+		string message;				//!< Message of Fault::RuntimeError
+	};
+
+	//! @brief Throw RuntimeError that matches a fault
+	//!
+	//! Used by throwing API (IArgument::getValue(), IOperation::execute())
+	//! @param record The fault
+	//! @throw RuntimeError
+	[[noreturn]] void throwFault(const FaultRecord & record);
+
+	//! @brief Get error message of a fault
+	//!
+	//! The message is the same as what() of the matching RuntimeError
+	//! @param record The fault
+	//! @return Error message
+	string faultMessage(const FaultRecord & record);
+}
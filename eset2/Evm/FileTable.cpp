@@ -0,0 +1,92 @@
+//! @file	FileTable.cpp
+//! @author	agent
+//! @date	10.2026
+//! @brief	FileTable class definition
+#include "stdafx.h"
+#include "FileTable.h"
+#include "PositionalFile.h"
+#include "RuntimeError.h"
+
+namespace Evm {
+	namespace Utils {
+		FileTable::FileTable(const string & manifestFileName)
+		{
+			if (manifestFileName.empty()) {
+				return;
+			}
+
+			ifstream manifest{ manifestFileName };
+			if (!manifest) {
+				throw InputFileRuntimeError{ manifestFileName, "Unable to open the manifest" };
+			}
+			string line;
+			while (getline(manifest, line)) {
+				if (!line.empty() && line.back() == '\r') {
+					line.pop_back();
+				}
+				if (!line.empty() && line.front() == WRITABLE_PREFIX) {
+					_manifest.push_back(Entry{ line.substr(1), Platform::FileAccess::Update });
+				}
+				else {
+					_manifest.push_back(Entry{ line, Platform::FileAccess::ReadSequential });
+				}
+			}
+			if (manifest.bad()) {
+				throw InputFileRuntimeError{ manifestFileName, "Unable to read the manifest" };
+			}
+		}
+
+		uint64_t FileTable::open(uint64_t index)
+		{
+			if (index >= _manifest.size()) {
+				throw BadManifestIndexRuntimeError{ index, _manifest.size() };
+			}
+
+			// the file is opened outside the guard, other threads use the table meanwhile
+			const auto & entry = _manifest[static_cast<size_t>(index)];
+			SharedFilePtr file = make_shared<PositionalFile>(entry.fileName, entry.access, 0);
+			lock_guard<mutex> lock(_guard);
+			uint64_t handle = _nextHandle++;
+			_files.emplace(handle, move(file));
+			_peakOpen = max(_peakOpen, _files.size());
+			return handle;
+		}
+
+		void FileTable::close(uint64_t handle)
+		{
+			SharedFilePtr file;
+			{
+				lock_guard<mutex> lock(_guard);
+				auto it = _files.find(handle);
+				if (it == _files.end()) {
+					throw BadFileHandleRuntimeError{ handle };
+				}
+				file = move(it->second);
+				_files.erase(it);
+			}
+			// the handle is closed here unless a thread still uses the file
+		}
+
+		FileTable::SharedFilePtr FileTable::get(uint64_t handle)
+		{
+			lock_guard<mutex> lock(_guard);
+			auto it = _files.find(handle);
+			if (it == _files.end()) {
+				throw BadFileHandleRuntimeError{ handle };
+			}
+			return it->second;
+		}
+
+		uint64_t FileTable::opens()
+		{
+			lock_guard<mutex> lock(_guard);
+			return _nextHandle - USER_FILES - 1;
+		}
+
+		size_t FileTable::peakOpen()
+		{
+			lock_guard<mutex> lock(_guard);
+			return _peakOpen;
+		}
+	}
+}
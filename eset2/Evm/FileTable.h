@@ -0,0 +1,83 @@
+//! @file	FileTable.h
+//! @author	agent
+//! @date	10.2026
+//! @brief	FileTable class declaration
+//!
+//! FileTable is the evm side file descriptor table. The files an evm program may open
+//! are listed in a manifest given on the command line, one path per line, and the program
+//! refers to them by index, the first line is 0. An entry is opened read only, a path
+//! prefixed with WRITABLE_PREFIX is opened for reading and writing. Missing files are
+//! not created. open makes a handle of a manifest entry, each handle has its own
+//! @ref PositionalFile, so threads that work on different files don't share anything but
+//! the table. A thread selects the file of its read/write instructions with useFile,
+//! handle 0 selects the user files (-i/-o). Handles are never reused.
+#pragma once
+
+#include "stdafx.h"
+#include "InputFile.h"
+
+namespace Evm {
+	namespace Utils {
+		//! @brief Table of files opened by evm program
+		struct FileTable {
+			using SharedFilePtr = shared_ptr<IFile>;	//!< An open file, kept by the table and by threads that use it
+
+			static constexpr uint64_t USER_FILES = 0;	//!< Handle of the files given with -i/-o
+			static constexpr char WRITABLE_PREFIX = '>';	//!< Marks manifest entries opened for writing
+
+			//! @brief Constructor
+			//!
+			//! Read the manifest, the files are opened by open(). Every line is an entry,
+			//! a blank line is an entry that can't be opened.
+			//! @param manifestFileName Name of the manifest, no entries if it is empty
+			//! @throw InputFileRuntimeError
+			FileTable(const string & manifestFileName);
+
+			//! @brief Open a manifest entry
+			//!
+			//! The file must exist. An entry may be opened many times.
+			//! @param index Index of the entry, the first line of the manifest is 0
+			//! @return Handle of the file
+			//! @throw BadManifestIndexRuntimeError, InputFileRuntimeError
+			uint64_t open(uint64_t index);
+
+			//! @brief Close a handle
+			//!
+			//! Threads that use the file keep it open until they select another one
+			//! @param handle The handle
+			//! @throw BadFileHandleRuntimeError
+			void close(uint64_t handle);
+
+			//! @brief Get the file of a handle
+			//!
+			//! @param handle The handle
+			//! @return The file
+			//! @throw BadFileHandleRuntimeError
+			SharedFilePtr get(uint64_t handle);
+
+			//! @brief Get number of manifest entries
+			size_t entries() const {
+				return _manifest.size();
+			}
+
+			//! @brief Get number of opened handles
+			uint64_t opens();
+
+			//! @brief Get the greatest number of handles open at once
+			size_t peakOpen();
+
+		private:
+			//! Manifest entry
+			struct Entry {
+				string fileName;				//!< Path of the file
+				Platform::FileAccess access;	//!< Read only or read and write
+			};
+
+			vector<Entry> _manifest;				//!< Entries by index
+			mutex _guard;							//!< Protects all members below
+			unordered_map<uint64_t, SharedFilePtr> _files;	//!< Handle -> open file
+			uint64_t _nextHandle = USER_FILES + 1;	//!< Handle of the next opened file
+			size_t _peakOpen = 0;					//!< The greatest size of _files
+		};
+	}
+}
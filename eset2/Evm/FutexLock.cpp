@@ -0,0 +1,88 @@
+//! @file	FutexLock.cpp
+//! @author	agent
+//! @date	10.2026
+//! @brief	FutexLock class definition
+#include "stdafx.h"
+#include "FutexLock.h"
+#include "Platform.h"
+
+namespace Evm {
+	namespace Utils {
+		bool FutexLock::lock()
+		{
+			uint32_t expected = UNLOCKED;
+			if (_state.compare_exchange_strong(expected, LOCKED, memory_order_acquire)) {
+				_acquired();
+				return true;
+			}
+			return _lockContended();
+		}
+
+		bool FutexLock::_tryAcquire()
+		{
+			uint32_t expected = UNLOCKED;
+			return _state.compare_exchange_strong(expected, LOCKED, memory_order_acquire);
+		}
+
+		void FutexLock::unlock()
+		{
+			// CAS instead of exchange, the cancelled state must not be overwritten
+			uint32_t state = _state.load(memory_order_relaxed);
+			while (state != CANCELLED && 
+				!_state.compare_exchange_weak(state, UNLOCKED, memory_order_release, memory_order_relaxed)) {
+			}
+			if (state == LOCKED_WITH_WAITERS) {
+				Platform::futexWakeOne(_state);
+			}
+		}
+
+		void FutexLock::cancel()
+		{
+			_state.store(CANCELLED);
+			Platform::futexWakeAll(_state);
+		}
+
+		bool FutexLock::_lockContended()
+		{
+			auto waitBegin = _waitBegin();
+
+			// spin phase - the owner will probably leave the critical section soon
+			for (uint32_t i = 0; i < SPIN_COUNT; i++) {
+				Platform::cpuRelax();
+				uint32_t state = _state.load(memory_order_relaxed);
+				if (state == CANCELLED) {
+					return false;
+				}
+				if (state == UNLOCKED &&
+					_state.compare_exchange_weak(state, LOCKED, memory_order_acquire)) {
+					_acquiredContended(waitBegin, 0);
+					return true;
+				}
+			}
+
+			// park phase. The lock is taken in LOCKED_WITH_WAITERS state, because we can't
+			// know whether other threads are still parked.
+			uint64_t parks = 0;
+			uint32_t state = _state.load(memory_order_relaxed);
+			while (true) {
+				if (state == CANCELLED) {
+					return false;
+				}
+				if (state == UNLOCKED) {
+					if (_state.compare_exchange_weak(state, LOCKED_WITH_WAITERS, memory_order_acquire)) {
+						break;
+					}
+					continue;
+				}
+				if (state == LOCKED && !_state.compare_exchange_weak(state, LOCKED_WITH_WAITERS)) {
+					continue;
+				}
+				Platform::futexWait(_state, LOCKED_WITH_WAITERS);
+				parks++;
+				state = _state.load(memory_order_relaxed);
+			}
+			_acquiredContended(waitBegin, parks);
+			return true;
+		}
+	}
+}
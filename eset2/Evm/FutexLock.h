@@ -0,0 +1,46 @@
+//! @file	FutexLock.h
+//! @author	agent
+//! @date	10.2026
+//! @brief	FutexLock class declaration
+//!
+//! FutexLock is the default lock behind evm lock/unlock instructions. Evm critical sections
+//! are usually very short (e.g. add-to-memory in lock.evm), so the lock spins for a while
+//! with a pause hint before the thread is parked on a futex. Unlike std::mutex,
+//! the lock may be released by a different thread than the one that obtained it.
+#pragma once
+
+#include "stdafx.h"
+#include "Lock.h"
+
+namespace Evm {
+	namespace Utils {
+		//! @brief Adaptive spin-then-park lock
+		//!
+		//! Three state futex lock: 0 - unlocked, 1 - locked, 2 - locked and there may be
+		//! parked waiters. unlock() issues a wake syscall only in the last state.
+		//! State 3 - cancelled - is final, it wakes all waiters.
+		//! The lock is not fair, a spinning thread may overtake parked ones.
+		struct FutexLock : ILock {
+			static constexpr uint32_t SPIN_COUNT = 100;		//!< Spin iterations before parking
+
+			using ILock::ILock;
+			virtual bool lock() override;
+			virtual void unlock() override;
+			virtual void cancel() override;
+
+		protected:
+			virtual bool _tryAcquire() override;
+
+		private:
+			static constexpr uint32_t UNLOCKED = 0;
+			static constexpr uint32_t LOCKED = 1;
+			static constexpr uint32_t LOCKED_WITH_WAITERS = 2;
+			static constexpr uint32_t CANCELLED = 3;
+
+			atomic<uint32_t> _state{ UNLOCKED };	//!< Futex word
+
+			//! @brief Helper function. Slow path of lock()
+			bool _lockContended();
+		};
+	}
+}
@@ -0,0 +1,53 @@
+//! @file	InputFile.cpp
+//! @author	agent
+//! @date	10.2026
+//! @brief	IFile factory
+#include "stdafx.h"
+#include "InputFile.h"
+#include "PositionalFile.h"
+#include "MappedFile.h"
+#include "CachedFile.h"
+#include "StreamFile.h"
+
+namespace Evm {
+	namespace Utils {
+		FilePtr makeFile(const string & fileName, const FileOptions & options)
+		{
+			auto positional = make_unique<PositionalFile>(fileName, options.access, options.expectedSize);
+
+			// pipes are transferred in order, a mapping or a cache needs positions.
+			// A pipe opened for reading and writing never ends and never loses its reader,
+			// the input file is only read and the output file is only written.
+			if (!Platform::isSeekable(positional->handle())) {
+				if (options.access == Platform::FileAccess::ReadWrite) {
+					positional = make_unique<PositionalFile>(fileName, Platform::FileAccess::ReadSequential, 0);
+				}
+				else if (options.access == Platform::FileAccess::Create) {
+					// a write after the reader is gone fails, the error is reported by the write instruction
+					Platform::ignoreBrokenPipe();
+					positional = make_unique<PositionalFile>(fileName, Platform::FileAccess::WriteSequential, 0);
+				}
+				return make_unique<StreamFile>(move(positional));
+			}
+			// nothing is written to a read only file, it is read with system read-ahead
+			if (options.access == Platform::FileAccess::ReadSequential) {
+				return FilePtr{ move(positional) };
+			}
+
+			FilePtr file;
+			switch (options.mode) {
+			case FileMode::Mapped:
+				file = make_unique<MappedFile>(move(positional));
+				break;
+			case FileMode::Positional:
+			default:
+				file = move(positional);
+				break;
+			}
+			if (options.writeCacheSize != 0) {
+				file = make_unique<CachedFile>(move(file), options.writeCacheSize);
+			}
+			return file;
+		}
+	}
+}
@@ -0,0 +1,102 @@
+//! @file	InputFile.h
+//! @author	agent
+//! @date	10.2026
+//! @brief	IFile interface
+//!
+//! IFile interface represents a user file, the file behind evm read/write instructions:
+//! the input file given with -i and, if it is given, the output file (-o) that takes
+//! the writes. The application selects an implementation with @ref FileMode: positional
+//! system calls for each operation (@ref PositionalFile) or a shared memory mapping
+//! (@ref MappedFile), which serves small reads and writes without system calls. Either
+//! of them may be wrapped in a write-back cache (@ref CachedFile) that coalesces small
+//! writes. A read only input file is always positional, the system reads it ahead.
+//! Files without positions (pipes) are streamed in order (@ref StreamFile) in any mode.
+//! Files of the manifest, opened by evm open instruction (@ref FileTable), are always positional.
+//! Implementations may be used by many threads at once.
+#pragma once
+
+#include "stdafx.h"
+#include "Platform.h"
+
+namespace Evm {
+	namespace Utils {
+		//! @brief File implementation selector
+		enum class FileMode {
+			Positional,		//!< pread/pwrite for each operation
+			Mapped			//!< Shared memory mapping, grown on demand
+		};
+
+		//! @brief User input file interface
+		struct IFile {
+			virtual ~IFile() = default;
+
+			//! @brief Read data block
+			//!
+			//! Read up to @ref size bytes from @ref offset. The result is shorter only
+			//! at the end of the file or on error.
+			//! @param offset Offset in the file
+			//! @param data Output buffer
+			//! @param size Number of bytes to read
+			//! @return Number of bytes read
+			virtual uint64_t read(uint64_t offset, Byte * data, uint64_t size) = 0;
+
+			//! @brief Write data block
+			//!
+			//! Write @ref size bytes at @ref offset. A gap between the end of the file
+			//! and @ref offset is filled with zeros.
+			//! @param offset Offset in the file
+			//! @param data Data to write
+			//! @param size Number of bytes to write
+			//! @return True if all the bytes have been written
+			virtual bool write(uint64_t offset, const Byte * data, uint64_t size) = 0;
+
+			//! @brief Write buffered data to the file
+			//!
+			//! Called at exit, when no thread uses the file. Destructors write the data
+			//! back as well, but they can't report errors.
+			//! @return True on success
+			virtual bool flush() = 0;
+
+			//! @brief Get size of the file
+			//!
+			//! Written data that are still buffered count as well
+			//! @return Size of the file in bytes, 0 on error
+			virtual uint64_t size() = 0;
+
+			//! @brief Get file name
+			virtual const string & name() const = 0;
+
+			//! @brief Get native handle of the file
+			//!
+			//! Backends that transfer data with the handle (@ref IoUringAsyncIo) bypass the
+			//! implementation, so only files that add nothing to plain reads and writes have it.
+			//! @param handle Output, the handle
+			//! @return True if the file has the handle
+			virtual bool nativeHandle(Platform::FileHandle & /*handle*/) const {
+				return false;
+			}
+
+			IFile() = default;
+			IFile(const IFile &) = delete;
+			IFile & operator=(const IFile &) = delete;
+		};
+
+		using FilePtr = unique_ptr<IFile>;
+
+		//! @brief Options of a user file
+		struct FileOptions {
+			FileMode mode = FileMode::Positional;	//!< File implementation, ignored for read only files
+			Platform::FileAccess access = Platform::FileAccess::ReadWrite;	//!< How the file is opened
+			uint64_t writeCacheSize = 0;	//!< Dirty data limit of the write-back cache, 0 - no cache
+			uint64_t expectedSize = 0;		//!< Disk space allocated in advance, 0 - none
+		};
+
+		//! @brief Open user file
+		//!
+		//! @param fileName Name of the file
+		//! @param options Implementation and access of the file
+		//! @return The file
+		//! @throw InputFileRuntimeError
+		FilePtr makeFile(const string & fileName, const FileOptions & options);
+	}
+}
@@ -0,0 +1,349 @@
+//! @file	IoUringAsyncIo.cpp
+//! @author	agent
+//! @date	10.2026
+//! @brief	IoUringAsyncIo class definition
+#include "stdafx.h"
+#include "IoUringAsyncIo.h"
+
+#ifdef __linux__
+#include <cerrno>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// system call numbers are the same on all architectures, older C libraries don't define them
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter 426
+#endif
+#ifndef __NR_io_uring_register
+#define __NR_io_uring_register 427
+#endif
+#endif
+
+namespace Evm {
+	namespace Utils {
+#ifdef __linux__
+		struct IoUringAsyncIo::Ring {
+			int fd = -1;							//!< Ring file descriptor
+			void * sqMemory = MAP_FAILED;			//!< Mapped submission ring
+			size_t sqSize = 0;						//!< Size of submission ring mapping
+			void * cqMemory = MAP_FAILED;			//!< Mapped completion ring, may be the same as sqMemory
+			size_t cqSize = 0;						//!< Size of completion ring mapping
+			io_uring_sqe * sqes = static_cast<io_uring_sqe *>(MAP_FAILED);	//!< Submission queue entries
+			size_t sqesSize = 0;					//!< Size of entries mapping
+			atomic<uint32_t> * sqHead = nullptr;	//!< Submission queue head, written by the kernel
+			atomic<uint32_t> * sqTail = nullptr;	//!< Submission queue tail, written by us
+			uint32_t sqMask = 0;					//!< Submission queue index mask
+			uint32_t * sqArray = nullptr;			//!< Submission queue -> entry index
+			atomic<uint32_t> * cqHead = nullptr;	//!< Completion queue head, written by us
+			atomic<uint32_t> * cqTail = nullptr;	//!< Completion queue tail, written by the kernel
+			uint32_t cqMask = 0;					//!< Completion queue index mask
+			io_uring_cqe * cqes = nullptr;			//!< Completion queue entries
+
+			~Ring() {
+				if (sqes != MAP_FAILED) {
+					munmap(sqes, sqesSize);
+				}
+				if (cqMemory != MAP_FAILED && cqMemory != sqMemory) {
+					munmap(cqMemory, cqSize);
+				}
+				if (sqMemory != MAP_FAILED) {
+					munmap(sqMemory, sqSize);
+				}
+				if (fd >= 0) {
+					close(fd);
+				}
+			}
+
+			//! @brief Submit entries and/or wait for completions
+			//! @return Number of submitted entries, -1 on error
+			int enter(uint32_t toSubmit, uint32_t minComplete, uint32_t flags) {
+				return static_cast<int>(syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+			}
+
+			//! @brief Pointer to a field of a ring mapping
+			template <typename T>
+			static T * field(void * memory, uint32_t offset) {
+				return reinterpret_cast<T *>(static_cast<uint8_t *>(memory) + offset);
+			}
+		};
+
+		unique_ptr<IoUringAsyncIo> IoUringAsyncIo::tryCreate()
+		{
+			io_uring_params params;
+			memset(&params, 0, sizeof(params));
+			auto ring = make_unique<Ring>();
+			ring->fd = static_cast<int>(syscall(__NR_io_uring_setup, RING_ENTRIES, &params));
+			if (ring->fd < 0) {
+				return nullptr;
+			}
+
+			ring->sqSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+			ring->cqSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+			bool singleMapping = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+			if (singleMapping) {
+				ring->sqSize = ring->cqSize = max(ring->sqSize, ring->cqSize);
+			}
+			ring->sqMemory = mmap(nullptr, ring->sqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+				ring->fd, IORING_OFF_SQ_RING);
+			ring->cqMemory = singleMapping ? ring->sqMemory : mmap(nullptr, ring->cqSize, PROT_READ | PROT_WRITE,
+				MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_CQ_RING);
+			ring->sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+			ring->sqes = static_cast<io_uring_sqe *>(mmap(nullptr, ring->sqesSize, PROT_READ | PROT_WRITE,
+				MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES));
+			if (ring->sqMemory == MAP_FAILED || ring->cqMemory == MAP_FAILED || ring->sqes == MAP_FAILED) {
+				return nullptr;
+			}
+			ring->sqHead = Ring::field<atomic<uint32_t>>(ring->sqMemory, params.sq_off.head);
+			ring->sqTail = Ring::field<atomic<uint32_t>>(ring->sqMemory, params.sq_off.tail);
+			ring->sqMask = *Ring::field<uint32_t>(ring->sqMemory, params.sq_off.ring_mask);
+			ring->sqArray = Ring::field<uint32_t>(ring->sqMemory, params.sq_off.array);
+			ring->cqHead = Ring::field<atomic<uint32_t>>(ring->cqMemory, params.cq_off.head);
+			ring->cqTail = Ring::field<atomic<uint32_t>>(ring->cqMemory, params.cq_off.tail);
+			ring->cqMask = *Ring::field<uint32_t>(ring->cqMemory, params.cq_off.ring_mask);
+			ring->cqes = Ring::field<io_uring_cqe>(ring->cqMemory, params.cq_off.cqes);
+
+			// read and write operations are supported since 5.6, so is the probe
+			const unsigned opCount = 256;
+			Bytes probeBuffer(sizeof(io_uring_probe) + opCount * sizeof(io_uring_probe_op));
+			auto probe = reinterpret_cast<io_uring_probe *>(probeBuffer.data());
+			if (syscall(__NR_io_uring_register, ring->fd, IORING_REGISTER_PROBE, probe, opCount) != 0 ||
+				probe->last_op < IORING_OP_WRITE ||
+				(probe->ops[IORING_OP_READ].flags & IO_URING_OP_SUPPORTED) == 0 ||
+				(probe->ops[IORING_OP_WRITE].flags & IO_URING_OP_SUPPORTED) == 0) {
+				return nullptr;
+			}
+
+			return unique_ptr<IoUringAsyncIo>{ new IoUringAsyncIo{ move(ring) } };
+		}
+
+		IoUringAsyncIo::IoUringAsyncIo(unique_ptr<Ring> ring) :
+			_ring{ move(ring) },
+			_reaper{ [this]() { _reap(); } }
+		{}
+
+		IoUringAsyncIo::~IoUringAsyncIo()
+		{
+			{
+				lock_guard<mutex> lock(_guard);
+				_isStopping = true;
+			}
+			_hasWork.notify_one();
+			_reaper.join();
+		}
+
+		void IoUringAsyncIo::submit(IoRequest & request)
+		{
+			unique_lock<mutex> lock(_guard);
+			_statistics.requests++;
+			_backlog.push_back(&request);
+			_submitBacklog(lock);
+		}
+
+		void IoUringAsyncIo::queue(IoRequest & request)
+		{
+			lock_guard<mutex> lock(_guard);
+			_statistics.requests++;
+			_backlog.push_back(&request);
+		}
+
+		void IoUringAsyncIo::submitQueued()
+		{
+			unique_lock<mutex> lock(_guard);
+			_submitBacklog(lock);
+		}
+
+		AsyncIoStatistics IoUringAsyncIo::statistics()
+		{
+			lock_guard<mutex> lock(_guard);
+			return _statistics;
+		}
+
+		void IoUringAsyncIo::_submitBacklog(unique_lock<mutex> & lock)
+		{
+			while (!_backlog.empty() && _inFlight < RING_ENTRIES) {
+				_fillEntry(*_backlog.front());
+				_backlog.pop_front();
+			}
+			if (_isSubmitting) {
+				return;
+			}
+
+			// entries filled by other threads during the call are submitted by the next one
+			_isSubmitting = true;
+			while (_unsubmitted != 0) {
+				uint32_t count = _unsubmitted;
+				_unsubmitted = 0;
+				_statistics.batches++;
+				lock.unlock();
+				int res = _ring->enter(count, 0, 0);
+				int error = (res < 0) ? errno : 0;
+				lock.lock();
+				uint32_t consumed = static_cast<uint32_t>(max(res, 0));
+				_unsubmitted += count - consumed;
+				if (consumed != 0) {
+					_hasWork.notify_one();
+				}
+				if (consumed == count || error == EINTR) {
+					continue;
+				}
+
+				// the kernel is short of resources. Not consumed entries stay in the queue, the reaper
+				// retries them after completions - but only if some entries are in the kernel.
+				if ((error == 0 || error == EAGAIN || error == EBUSY) && _inFlight > _unsubmitted) {
+					break;
+				}
+				_failUnsubmitted();
+			}
+			_isSubmitting = false;
+		}
+
+		void IoUringAsyncIo::_failUnsubmitted()
+		{
+			// the kernel reads the queue only in io_uring_enter, entries behind its head are taken back
+			auto & ring = *_ring;
+			uint32_t head = ring.sqHead->load(memory_order_acquire);
+			uint32_t tail = ring.sqTail->load(memory_order_relaxed);
+			for (uint32_t i = head; i != tail; i++) {
+				const io_uring_sqe & entry = ring.sqes[ring.sqArray[i & ring.sqMask]];
+				_fail(*reinterpret_cast<IoRequest *>(static_cast<uintptr_t>(entry.user_data)));
+			}
+			ring.sqTail->store(head, memory_order_release);
+			_inFlight -= tail - head;
+			_unsubmitted = 0;
+
+			// the backlog would wait for completions of the failed entries
+			for (auto request : _backlog) {
+				_fail(*request);
+			}
+			_backlog.clear();
+		}
+
+		void IoUringAsyncIo::_fail(IoRequest & request)
+		{
+			request.failed = true;
+			request.transferred = 0;
+			request.complete();
+		}
+
+		void IoUringAsyncIo::_fillEntry(IoRequest & request)
+		{
+			auto & ring = *_ring;
+			uint32_t tail = ring.sqTail->load(memory_order_relaxed);
+			uint32_t index = tail & ring.sqMask;
+			io_uring_sqe & entry = ring.sqes[index];
+			memset(&entry, 0, sizeof(entry));
+			uint64_t chunk = min(request.size - request.transferred, static_cast<uint64_t>(MAX_TRANSFER));
+			Platform::FileHandle file = Platform::INVALID_FILE;
+			request.file->nativeHandle(file);
+			entry.opcode = (request.type == IoRequest::Type::Read) ? IORING_OP_READ : IORING_OP_WRITE;
+			entry.fd = static_cast<int>(file);
+			entry.off = request.offset + request.transferred;
+			entry.addr = reinterpret_cast<uintptr_t>(request.data + request.transferred);
+			entry.len = static_cast<uint32_t>(chunk);
+			entry.user_data = reinterpret_cast<uintptr_t>(&request);
+			ring.sqArray[index] = index;
+			ring.sqTail->store(tail + 1, memory_order_release);
+			_inFlight++;
+			_unsubmitted++;
+		}
+
+		void IoUringAsyncIo::_reap()
+		{
+			auto & ring = *_ring;
+			vector<IoRequest *> done;
+			uint32_t backoff = 0;
+			unique_lock<mutex> lock(_guard);
+			while (true) {
+				// only entries in the kernel complete, the reaper sleeps until there are some
+				_hasWork.wait(lock, [this]() { return _isStopping || _inFlight > _unsubmitted; });
+				if (_inFlight == _unsubmitted) {
+					return;
+				}
+				lock.unlock();
+
+				// an interrupted wait only rescans the queue. On other errors the queue is polled
+				// with growing pauses, the kernel posts completions anyway.
+				if (ring.enter(0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR) {
+					backoff = (backoff == 0) ? 1 : min(backoff * 2, static_cast<uint32_t>(MAX_BACKOFF_MS));
+					this_thread::sleep_for(chrono::milliseconds(backoff));
+				}
+				else {
+					backoff = 0;
+				}
+
+				lock.lock();
+				uint32_t head = ring.cqHead->load(memory_order_relaxed);
+				uint32_t tail = ring.cqTail->load(memory_order_acquire);
+				for (; head != tail; head++) {
+					const io_uring_cqe & completion = ring.cqes[head & ring.cqMask];
+					auto request = reinterpret_cast<IoRequest *>(static_cast<uintptr_t>(completion.user_data));
+					_inFlight--;
+					if (completion.res == -EINTR || completion.res == -EAGAIN) {
+						_backlog.push_back(request);
+						continue;
+					}
+					if (completion.res < 0) {
+						request->failed = true;
+						done.push_back(request);
+						continue;
+					}
+
+					// the rest of a short transfer is submitted again, end of file ends it
+					request->transferred += static_cast<uint64_t>(completion.res);
+					if (completion.res > 0 && request->transferred < request->size) {
+						_backlog.push_back(request);
+						continue;
+					}
+					if (request->type == IoRequest::Type::Write && request->transferred < request->size) {
+						request->failed = true;
+					}
+					done.push_back(request);
+				}
+				ring.cqHead->store(head, memory_order_release);
+				_submitBacklog(lock);
+				lock.unlock();
+
+				for (auto request : done) {
+					request->complete();
+				}
+				done.clear();
+				lock.lock();
+			}
+		}
+#else
+		struct IoUringAsyncIo::Ring {
+		};
+
+		unique_ptr<IoUringAsyncIo> IoUringAsyncIo::tryCreate()
+		{
+			return nullptr;
+		}
+
+		IoUringAsyncIo::~IoUringAsyncIo()
+		{
+		}
+
+		void IoUringAsyncIo::submit(IoRequest & /*request*/)
+		{
+		}
+
+		void IoUringAsyncIo::queue(IoRequest & /*request*/)
+		{
+		}
+
+		void IoUringAsyncIo::submitQueued()
+		{
+		}
+
+		AsyncIoStatistics IoUringAsyncIo::statistics()
+		{
+			return _statistics;
+		}
+#endif
+	}
+}
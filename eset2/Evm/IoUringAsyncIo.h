@@ -0,0 +1,92 @@
+//! @file	IoUringAsyncIo.h
+//! @author	agent
+//! @date	10.2026
+//! @brief	IoUringAsyncIo class declaration
+//!
+//! IoUringAsyncIo submits requests to a Linux io_uring with raw system calls (no liburing).
+//! Submitting threads fill submission queue entries under a lock, the first of them
+//! enters the kernel and keeps submitting until no entries are left, so requests of
+//! threads that arrive meanwhile share one io_uring_enter call. A reaper thread waits
+//! for completions, resubmits the rest of short transfers and completes the requests.
+//! Requests that don't fit in the ring wait in a backlog. When the kernel doesn't take
+//! entries and nothing is in flight, the entries and the backlog fail, they would never
+//! be submitted otherwise.
+//! The backend is available on Linux only, with a kernel that supports read and write
+//! operations (5.6+).
+#pragma once
+
+#include "stdafx.h"
+#include "AsyncIo.h"
+#include "Platform.h"
+
+namespace Evm {
+	namespace Utils {
+		//! @brief Asynchronous I/O on io_uring
+		struct IoUringAsyncIo : IAsyncIo {
+			static constexpr uint32_t RING_ENTRIES = 256;		//!< Size of the submission queue
+			static constexpr uint64_t MAX_TRANSFER = 1 << 30;	//!< The greatest block of a single operation
+			static constexpr uint32_t MAX_BACKOFF_MS = 100;		//!< The longest pause of the reaper after errors
+
+			//! @brief Create the backend
+			//!
+			//! Files of the requests must have native handles
+			//! @return The backend, nullptr if io_uring is not available
+			static unique_ptr<IoUringAsyncIo> tryCreate();
+
+			//! @brief Destructor
+			//!
+			//! Stop the reaper and release the ring
+			//! @note Call it when there are no requests in flight
+			~IoUringAsyncIo() override;
+
+			void submit(IoRequest & request) override;
+
+			void queue(IoRequest & request) override;
+
+			void submitQueued() override;
+
+			const char * name() const override {
+				return "io_uring";
+			}
+
+			AsyncIoStatistics statistics() override;
+
+		private:
+			//! Mapped ring of the kernel
+			struct Ring;
+
+			unique_ptr<Ring> _ring;			//!< The ring
+			mutex _guard;					//!< Protects all members below
+			deque<IoRequest *> _backlog;	//!< Requests without a submission queue entry
+			uint32_t _inFlight = 0;			//!< Entries in the kernel, never more than RING_ENTRIES
+			uint32_t _unsubmitted = 0;		//!< Entries filled, but not submitted yet
+			bool _isSubmitting = false;		//!< True if a thread is entering the kernel
+			bool _isStopping = false;		//!< True if the reaper should stop
+			condition_variable _hasWork;	//!< Signaled when entries enter the kernel or on stop
+			AsyncIoStatistics _statistics;	//!< Statistics
+			thread _reaper;					//!< Completion thread
+
+			//! @brief Constructor
+			IoUringAsyncIo(unique_ptr<Ring> ring);
+
+			//! @brief Helper function. Move backlog to free entries and submit them
+			//!
+			//! Unless other thread is submitting, then the thread submits them as well
+			//! @param lock Lock of _guard, it is released during the system call
+			void _submitBacklog(unique_lock<mutex> & lock);
+
+			//! @brief Helper function. Fail not submitted entries and the backlog, call it with _guard locked
+			void _failUnsubmitted();
+
+			//! @brief Helper function. Complete a request that can't be submitted
+			static void _fail(IoRequest & request);
+
+			//! @brief Helper function. Fill a submission queue entry, call it with _guard locked
+			//! @param request The request
+			void _fillEntry(IoRequest & request);
+
+			//! @brief Helper function. Reaper loop
+			void _reap();
+		};
+	}
+}
@@ -0,0 +1,145 @@
+//! @file	Lock.cpp
+//! @author	agent
+//! @date	10.2026
+//! @brief	ILock interface definition
+#include "stdafx.h"
+#include "Lock.h"
+#include "FutexLock.h"
+#include "TicketLock.h"
+
+namespace Evm {
+	namespace Utils {
+		void WaitHistogram::add(uint64_t ns)
+		{
+			size_t bucket = 0;
+			for (uint64_t v = ns >> 1; v != 0 && bucket < _buckets.size() - 1; v >>= 1) {
+				bucket++;
+			}
+			_buckets[bucket]++;
+			if (ns > _max) {
+				_max = ns;
+			}
+		}
+
+		uint64_t WaitHistogram::count() const
+		{
+			uint64_t res = 0;
+			for (auto c : _buckets) {
+				res += c;
+			}
+			return res;
+		}
+
+		uint64_t WaitHistogram::percentile(double p) const
+		{
+			uint64_t total = count();
+			if (total == 0) {
+				return 0;
+			}
+
+			// rank of the sample, rounded up
+			uint64_t rank = static_cast<uint64_t>(ceil(p / 100.0 * total));
+			uint64_t seen = 0;
+			for (size_t i = 0; i < _buckets.size(); i++) {
+				seen += _buckets[i];
+				if (seen >= rank && seen > 0) {
+					uint64_t upperBound = uint64_t{ 2 } << i;
+					return (upperBound < _max) ? upperBound : _max;
+				}
+			}
+			return _max;
+		}
+
+		uint64_t WaitHistogram::max() const
+		{
+			return _max;
+		}
+
+		WaitHistogram & WaitHistogram::operator+=(const WaitHistogram & other)
+		{
+			for (size_t i = 0; i < _buckets.size(); i++) {
+				_buckets[i] += other._buckets[i];
+			}
+			if (other._max > _max) {
+				_max = other._max;
+			}
+			return *this;
+		}
+
+		LockStatistics & LockStatistics::operator+=(const LockStatistics & other)
+		{
+			acquisitions += other.acquisitions;
+			contended += other.contended;
+			parks += other.parks;
+			waitTimes += other.waitTimes;
+			return *this;
+		}
+
+		ILock::ILock(bool collectWaitTimes) :
+			_waitTimes{ collectWaitTimes ? make_unique<WaitHistogram>() : nullptr }
+		{}
+
+		LockStatistics ILock::statistics() const
+		{
+			LockStatistics res;
+			res.acquisitions = _acquisitions;
+			res.contended = _contended;
+			res.parks = _parks;
+			if (_waitTimes) {
+				res.waitTimes = *_waitTimes;
+			}
+			return res;
+		}
+
+		bool ILock::tryLock()
+		{
+			if (!_tryAcquire()) {
+				return false;
+			}
+			_acquired();
+			return true;
+		}
+
+		bool ILock::retryLock(Clock::time_point waitBegin)
+		{
+			if (!_tryAcquire()) {
+				return false;
+			}
+			_acquiredContended(waitBegin, 0);
+			return true;
+		}
+
+		void ILock::_acquired()
+		{
+			_acquisitions++;
+		}
+
+		ILock::Clock::time_point ILock::_waitBegin() const
+		{
+			// don't pay for the clock when the histogram is disabled
+			return _waitTimes ? Clock::now() : Clock::time_point{};
+		}
+
+		void ILock::_acquiredContended(Clock::time_point waitBegin, uint64_t parks)
+		{
+			_acquisitions++;
+			_contended++;
+			_parks += parks;
+			if (_waitTimes) {
+				auto waitTime = chrono::duration_cast<chrono::nanoseconds>(Clock::now() - waitBegin).count();
+				_waitTimes->add(static_cast<uint64_t>(waitTime));
+			}
+		}
+
+		LockPtr makeLock(LockPolicy policy, bool collectWaitTimes)
+		{
+			switch (policy) {
+			case LockPolicy::Ticket:
+				return make_unique<TicketLock>(collectWaitTimes);
+			case LockPolicy::Futex:
+			default:
+				return make_unique<FutexLock>(collectWaitTimes);
+			}
+		}
+	}
+}
@@ -0,0 +1,160 @@
+//! @file	Lock.h
+//! @author	agent
+//! @date	10.2026
+//! @brief	ILock interface
+//!
+//! ILock interface represents a lock behind evm lock/unlock instructions.
+//! Evm locks may be released by other thread than the one that obtained them,
+//! so implementations can't be plain std::mutex. The application selects
+//! an implementation with @ref LockPolicy: unfair spin-then-park futex lock
+//! (the fastest under low contention) or FIFO fair ticket lock (bounded wait time
+//! under heavy contention). Each lock collects contention counters and, optionally,
+//! a histogram of wait times of contended acquisitions. Uncontended acquisitions
+//! don't wait, they would only pull the percentiles down to 0.
+#pragma once
+
+#include "stdafx.h"
+
+namespace Evm {
+	namespace Utils {
+		//! @brief Lock implementation selector
+		enum class LockPolicy {
+			Futex,		//!< Adaptive spin-then-park lock, unfair
+			Ticket		//!< FIFO fair ticket lock
+		};
+
+		//! @brief Histogram of lock wait times
+		//!
+		//! Bucket i counts waits in range [2^i; 2^(i+1)) ns, bucket 0 also counts
+		//! waits shorter than 1 ns.
+		struct WaitHistogram {
+			static constexpr size_t BUCKET_COUNT = 40;	//!< Up to ~18 minutes
+
+			//! @brief Add wait time
+			//! @param ns Wait time in nanoseconds
+			void add(uint64_t ns);
+
+			//! @brief Get number of samples
+			uint64_t count() const;
+
+			//! @brief Get percentile
+			//!
+			//! Return upper bound of the bucket that contains given percentile
+			//! @param p Percentile in range [0; 100]
+			//! @return Wait time in nanoseconds
+			uint64_t percentile(double p) const;
+
+			//! @brief Get the longest wait time in nanoseconds
+			uint64_t max() const;
+
+			WaitHistogram & operator+=(const WaitHistogram & other);
+
+		private:
+			array<uint64_t, BUCKET_COUNT> _buckets{};	//!< Sample counters
+			uint64_t _max = 0;							//!< The longest wait
+		};
+
+		//! @brief Lock contention counters
+		struct LockStatistics {
+			uint64_t acquisitions = 0;		//!< Number of obtained locks
+			uint64_t contended = 0;			//!< Acquisitions that didn't succeed at first try
+			uint64_t parks = 0;				//!< Number of times a thread was parked
+			WaitHistogram waitTimes;		//!< Wait times of contended acquisitions, empty if not collected
+
+			LockStatistics & operator+=(const LockStatistics & other);
+		};
+
+		//! @brief ILock interface. Abstraction of evm lock
+		//!
+		//! Besides lock() and unlock() the interface keeps statistics. The counters
+		//! are updated by implementations while the lock is held, so they don't need
+		//! to be atomic.
+		struct ILock {
+			using Clock = chrono::steady_clock;
+
+			//! @brief Constructor
+			//!
+			//! @param collectWaitTimes True if wait time histogram should be collected
+			ILock(bool collectWaitTimes);
+
+			//! @brief Virtual destructor
+			virtual ~ILock() = default;
+
+			//! @brief Obtain the lock
+			//!
+			//! @note Blocking function, returns early when the lock is cancelled
+			//! @return True if the lock has been obtained, false if it has been cancelled
+			virtual bool lock() = 0;
+
+			//! @brief Try to obtain the lock
+			//!
+			//! @note Non-blocking function
+			//! @return True if the lock has been obtained
+			bool tryLock();
+
+			//! @brief Try to obtain the lock again after tryLock() failed
+			//!
+			//! Used under RoundRobinScheduler, where a thread yields instead of blocking.
+			//! The acquisition is counted as contended, with the wait from waitBegin.
+			//! @note Non-blocking function
+			//! @param waitBegin Time of the first failed attempt
+			//! @return True if the lock has been obtained
+			bool retryLock(Clock::time_point waitBegin);
+
+			//! @brief Release the lock
+			//!
+			//! Unlock of a free lock is ignored
+			//! @note The lock may be released by any thread
+			virtual void unlock() = 0;
+
+			//! @brief Cancel the lock
+			//!
+			//! Wake all waiters, they return from lock() without the lock. The lock
+			//! can't be obtained anymore. Used at shutdown, when owners of evm locks
+			//! are terminated and will never release them.
+			virtual void cancel() = 0;
+
+			//! @brief Get contention counters
+			//!
+			//! @note Read them when no thread uses the lock
+			LockStatistics statistics() const;
+
+			ILock(const ILock &) = delete;
+			ILock & operator=(const ILock &) = delete;
+
+		protected:
+			//! @brief Obtain the lock if it is free, without bookkeeping
+			//!
+			//! @note Non-blocking function
+			//! @return True if the lock has been obtained
+			virtual bool _tryAcquire() = 0;
+
+			//! @brief Bookkeeping after fast path acquisition
+			void _acquired();
+
+			//! @brief Start of a wait, call before the slow path
+			Clock::time_point _waitBegin() const;
+
+			//! @brief Bookkeeping after slow path acquisition
+			//!
+			//! @param waitBegin Value returned by _waitBegin()
+			//! @param parks Number of times the thread was parked
+			void _acquiredContended(Clock::time_point waitBegin, uint64_t parks);
+
+		private:
+			uint64_t _acquisitions = 0;				//!< Number of obtained locks
+			uint64_t _contended = 0;				//!< Contended acquisitions
+			uint64_t _parks = 0;					//!< Number of parks
+			unique_ptr<WaitHistogram> _waitTimes;	//!< Wait times, null if not collected
+		};
+
+		using LockPtr = unique_ptr<ILock>;
+
+		//! @brief Lock factory
+		//!
+		//! @param policy Lock implementation
+		//! @param collectWaitTimes True if wait time histogram should be collected
+		//! @return New lock
+		LockPtr makeLock(LockPolicy policy, bool collectWaitTimes);
+	}
+}
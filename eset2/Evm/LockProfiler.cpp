@@ -0,0 +1,175 @@
+//! @file	LockProfiler.cpp
+//! @author	agent
+//! @date	10.2026
+//! @brief	LockProfiler class definition
+#include "stdafx.h"
+#include "LockProfiler.h"
+
+namespace Evm {
+	namespace Utils {
+		bool LockProfiler::lock(ILock & lock, uint64_t lockID, uint32_t programCounter)
+		{
+			auto & profile = _profile(lockID);
+
+			auto waitBegin = Clock::now();
+			bool contended = !lock.tryLock();
+			if (contended && !lock.lock()) {
+				return false;
+			}
+			auto acquiredAt = Clock::now();
+
+			lock_guard<mutex> guard(profile.guard);
+			profile.acquisitions++;
+			if (contended) {
+				uint64_t wait = chrono::duration_cast<chrono::nanoseconds>(acquiredAt - waitBegin).count();
+				profile.contended++;
+				profile.totalWait += wait;
+				profile.maxWait = (wait > profile.maxWait) ? wait : profile.maxWait;
+			}
+			profile.acquirers[programCounter]++;
+			profile.acquiredAt = acquiredAt;
+			profile.held = true;
+			return true;
+		}
+
+		bool LockProfiler::tryLock(ILock & lock, uint64_t lockID, uint32_t programCounter)
+		{
+			auto & profile = _profile(lockID);
+			if (!lock.tryLock()) {
+				return false;
+			}
+
+			lock_guard<mutex> guard(profile.guard);
+			profile.acquisitions++;
+			profile.acquirers[programCounter]++;
+			profile.acquiredAt = Clock::now();
+			profile.held = true;
+			return true;
+		}
+
+		bool LockProfiler::retryLock(ILock & lock, uint64_t lockID, uint32_t programCounter, Clock::time_point waitBegin)
+		{
+			auto & profile = _profile(lockID);
+			if (!lock.retryLock(waitBegin)) {
+				return false;
+			}
+			auto acquiredAt = Clock::now();
+
+			lock_guard<mutex> guard(profile.guard);
+			uint64_t wait = chrono::duration_cast<chrono::nanoseconds>(acquiredAt - waitBegin).count();
+			profile.acquisitions++;
+			profile.contended++;
+			profile.totalWait += wait;
+			profile.maxWait = (wait > profile.maxWait) ? wait : profile.maxWait;
+			profile.acquirers[programCounter]++;
+			profile.acquiredAt = acquiredAt;
+			profile.held = true;
+			return true;
+		}
+
+		void LockProfiler::unlock(ILock & lock, uint64_t lockID)
+		{
+			auto & profile = _profile(lockID);
+			{
+				// the hold ends before the lock is released, the next owner starts a new one
+				lock_guard<mutex> guard(profile.guard);
+				if (profile.held) {
+					uint64_t hold = chrono::duration_cast<chrono::nanoseconds>(Clock::now() - profile.acquiredAt).count();
+					profile.totalHold += hold;
+					profile.maxHold = (hold > profile.maxHold) ? hold : profile.maxHold;
+					profile.held = false;
+				}
+			}
+			lock.unlock();
+		}
+
+		void LockProfiler::printTable(ostream & os)
+		{
+			ios_base::fmtflags flags{ os.flags() };
+			os << "Lock profile:\n";
+			os << setw(20) << "lock id" << setw(14) << "acquisitions" << setw(12) << "contended" <<
+				setw(16) << "wait total[us]" << setw(14) << "wait max[us]" <<
+				setw(16) << "hold total[us]" << setw(14) << "hold max[us]" << "  top acquirers (pc:count)\n";
+
+			for (auto & p : _sortedProfiles()) {
+				const LockProfile & profile = *p.second;
+				os << setw(20) << p.first << setw(14) << profile.acquisitions << setw(12) << profile.contended <<
+					setw(16) << profile.totalWait / 1000 << setw(14) << profile.maxWait / 1000 <<
+					setw(16) << profile.totalHold / 1000 << setw(14) << profile.maxHold / 1000 << " ";
+				for (auto & a : _topAcquirers(profile)) {
+					os << " 0x" << hex << setfill('0') << setw(8) << a.first << dec << setfill(' ') << ":" << a.second;
+				}
+				os << "\n";
+			}
+			os.flags(flags);
+		}
+
+		void LockProfiler::printJson(ostream & os)
+		{
+			os << "{\n\t\"locks\": [";
+			bool first = true;
+			for (auto & p : _sortedProfiles()) {
+				const LockProfile & profile = *p.second;
+				os << (first ? "\n" : ",\n");
+				first = false;
+
+				os << "\t\t{ \"id\": " << p.first <<
+					", \"acquisitions\": " << profile.acquisitions <<
+					", \"contended\": " << profile.contended <<
+					", \"waitTotalNs\": " << profile.totalWait <<
+					", \"waitMaxNs\": " << profile.maxWait <<
+					", \"holdTotalNs\": " << profile.totalHold <<
+					", \"holdMaxNs\": " << profile.maxHold <<
+					", \"topAcquirers\": [";
+				bool firstAcquirer = true;
+				for (auto & a : _topAcquirers(profile)) {
+					os << (firstAcquirer ? " " : ", ") << "{ \"pc\": " << a.first << ", \"count\": " << a.second << " }";
+					firstAcquirer = false;
+				}
+				os << " ] }";
+			}
+			os << "\n\t]\n}\n";
+		}
+
+		LockProfile & LockProfiler::_profile(uint64_t lockID)
+		{
+			uint64_t hash = lockID * 0x9e3779b97f4a7c15u;
+			Shard & shard = _shards[(hash >> 58) & (SHARD_COUNT - 1)];
+
+			// references to unordered_map elements survive rehashing
+			lock_guard<mutex> guard(shard.guard);
+			return shard.profiles[lockID];
+		}
+
+		vector<pair<uint64_t, const LockProfile *>> LockProfiler::_sortedProfiles()
+		{
+			vector<pair<uint64_t, const LockProfile *>> res;
+			for (auto & shard : _shards) {
+				lock_guard<mutex> guard(shard.guard);
+				for (auto & p : shard.profiles) {
+					res.emplace_back(p.first, &p.second);
+				}
+			}
+
+			sort(begin(res), end(res), [](const pair<uint64_t, const LockProfile *> & a, const pair<uint64_t, const LockProfile *> & b) {
+				if (a.second->totalWait != b.second->totalWait) {
+					return a.second->totalWait > b.second->totalWait;
+				}
+				return a.first < b.first;
+			});
+			return res;
+		}
+
+		vector<pair<uint32_t, uint64_t>> LockProfiler::_topAcquirers(const LockProfile & profile)
+		{
+			vector<pair<uint32_t, uint64_t>> res(begin(profile.acquirers), end(profile.acquirers));
+			sort(begin(res), end(res), [](const pair<uint32_t, uint64_t> & a, const pair<uint32_t, uint64_t> & b) {
+				return (a.second != b.second) ? a.second > b.second : a.first < b.first;
+			});
+			if (res.size() > TOP_ACQUIRERS) {
+				res.resize(TOP_ACQUIRERS);
+			}
+			return res;
+		}
+	}
+}
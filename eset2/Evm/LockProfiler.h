@@ -0,0 +1,108 @@
+//! @file	LockProfiler.h
+//! @author	agent
+//! @date	10.2026
+//! @brief	LockProfiler class declaration
+//!
+//! LockProfiler records per lock ID statistics of evm locks: number of acquisitions,
+//! contended acquisitions, wait and hold times and program counters of the instructions
+//! that obtain the lock. The application creates the profiler only when it is requested,
+//! so the cost of disabled profiling is a single branch in Application::lock()/unlock().
+#pragma once
+
+#include "stdafx.h"
+#include "Lock.h"
+
+namespace Evm {
+	namespace Utils {
+		//! @brief Profile of a single evm lock
+		struct LockProfile {
+			mutex guard;					//!< Protects the record
+			uint64_t acquisitions = 0;		//!< Number of obtained locks
+			uint64_t contended = 0;			//!< Acquisitions that had to wait
+			uint64_t totalWait = 0;			//!< Total wait time [ns]
+			uint64_t maxWait = 0;			//!< The longest wait [ns]
+			uint64_t totalHold = 0;			//!< Total hold time [ns]
+			uint64_t maxHold = 0;			//!< The longest hold time [ns]
+			unordered_map<uint32_t, uint64_t> acquirers;	//!< Program counter -> number of acquisitions
+			chrono::steady_clock::time_point acquiredAt;	//!< Time of the last acquisition
+			bool held = false;				//!< True if acquiredAt is valid
+		};
+
+		//! @brief Per lock ID contention profiler
+		//!
+		//! The profiler wraps lock() and unlock() of evm locks. Each profile record has its own
+		//! mutex. The profiled lock doesn't protect the record - an evm thread may unlock a lock
+		//! it doesn't hold, or one that is free.
+		struct LockProfiler {
+			static constexpr size_t SHARD_COUNT = 64;		//!< Number of hash map shards (power of 2)
+			static constexpr size_t TOP_ACQUIRERS = 5;		//!< Number of reported program counters
+
+			//! @brief Obtain a lock and record the acquisition
+			//!
+			//! @param lock The lock
+			//! @param lockID ID of the lock
+			//! @param programCounter Address of the lock instruction
+			//! @note Blocking function
+			//! @return True if the lock has been obtained, false if it has been cancelled
+			bool lock(ILock & lock, uint64_t lockID, uint32_t programCounter);
+
+			//! @brief Try to obtain a lock and record the acquisition
+			//!
+			//! @param lock The lock
+			//! @param lockID ID of the lock
+			//! @param programCounter Address of the lock instruction
+			//! @note Non-blocking function
+			//! @return True if the lock has been obtained
+			bool tryLock(ILock & lock, uint64_t lockID, uint32_t programCounter);
+
+			//! @brief Try to obtain a lock again after tryLock() failed and record a contended acquisition
+			//!
+			//! @param lock The lock
+			//! @param lockID ID of the lock
+			//! @param programCounter Address of the lock instruction
+			//! @param waitBegin Time of the first failed attempt
+			//! @note Non-blocking function
+			//! @return True if the lock has been obtained
+			bool retryLock(ILock & lock, uint64_t lockID, uint32_t programCounter, chrono::steady_clock::time_point waitBegin);
+
+			//! @brief Record the hold time and release a lock
+			//!
+			//! @param lock The lock
+			//! @param lockID ID of the lock
+			void unlock(ILock & lock, uint64_t lockID);
+
+			//! @brief Print the profile as a table
+			//!
+			//! Locks are sorted by total wait time, the most contended first.
+			//! @note Call it when evm threads are done
+			//! @param os Output stream
+			void printTable(ostream & os);
+
+			//! @brief Print the profile as JSON
+			//!
+			//! @note Call it when evm threads are done
+			//! @param os Output stream
+			void printJson(ostream & os);
+
+		private:
+			using Clock = chrono::steady_clock;
+
+			//! Hash map shard
+			struct Shard {
+				mutex guard;									//!< Protects the map, not the records
+				unordered_map<uint64_t, LockProfile> profiles;	//!< Lock ID -> profile
+			};
+
+			array<Shard, SHARD_COUNT> _shards;	//!< Profile records
+
+			//! @brief Helper function. Get profile record of given lock, create if it doesn't exist
+			LockProfile & _profile(uint64_t lockID);
+
+			//! @brief Helper function. All records sorted by total wait time, descending
+			vector<pair<uint64_t, const LockProfile *>> _sortedProfiles();
+
+			//! @brief Helper function. The most frequent acquirers of a lock
+			static vector<pair<uint32_t, uint64_t>> _topAcquirers(const LockProfile & profile);
+		};
+	}
+}
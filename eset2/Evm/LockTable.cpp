@@ -0,0 +1,95 @@
+//! @file	LockTable.cpp
+//! @author	agent
+//! @date	10.2026
+//! @brief	LockTable class definition
+#include "stdafx.h"
+#include "LockTable.h"
+
+namespace Evm {
+	namespace Utils {
+		LockTable::LockTable(LockPolicy policy, bool collectWaitTimes) :
+			_policy{ policy },
+			_collectWaitTimes{ collectWaitTimes },
+			_dense{ make_unique<DenseSlot[]>(DENSE_LOCK_COUNT) }
+		{
+			for (uint64_t i = 0; i < DENSE_LOCK_COUNT; i++) {
+				_dense[i].lock = makeLock(_policy, _collectWaitTimes);
+			}
+		}
+
+		LockTable::Lock & LockTable::get(uint64_t lockID)
+		{
+			if (lockID < DENSE_LOCK_COUNT) {
+				// fast path, no hashing and no shared state besides the lock itself
+				DenseSlot & slot = _dense[lockID];
+				if (!slot.used.load(memory_order_relaxed)) {
+					slot.used.store(true, memory_order_relaxed);
+				}
+				return *slot.lock;
+			}
+
+			Shard & shard = _shard(lockID);
+			lock_guard<mutex> guard(shard.guard);
+			auto & lockPtr = shard.locks[lockID];
+			if (!lockPtr) {
+				lockPtr = makeLock(_policy, _collectWaitTimes);
+				if (_isCancelled.load()) {
+					lockPtr->cancel();
+				}
+			}
+			return *lockPtr;
+		}
+
+		LockTable::Lock * LockTable::find(uint64_t lockID)
+		{
+			if (lockID < DENSE_LOCK_COUNT) {
+				DenseSlot & slot = _dense[lockID];
+				return slot.used.load(memory_order_relaxed) ? slot.lock.get() : nullptr;
+			}
+
+			Shard & shard = _shard(lockID);
+			lock_guard<mutex> guard(shard.guard);
+			auto it = shard.locks.find(lockID);
+			return (it != end(shard.locks)) ? it->second.get() : nullptr;
+		}
+
+		LockStatistics LockTable::statistics()
+		{
+			LockStatistics res;
+			for (uint64_t i = 0; i < DENSE_LOCK_COUNT; i++) {
+				if (_dense[i].used.load(memory_order_relaxed)) {
+					res += _dense[i].lock->statistics();
+				}
+			}
+			for (auto & shard : _shards) {
+				lock_guard<mutex> guard(shard.guard);
+				for (auto & l : shard.locks) {
+					res += l.second->statistics();
+				}
+			}
+			return res;
+		}
+
+		void LockTable::cancel()
+		{
+			// set the flag first, get() checks it under the shard guard
+			_isCancelled.store(true);
+			for (uint64_t i = 0; i < DENSE_LOCK_COUNT; i++) {
+				_dense[i].lock->cancel();
+			}
+			for (auto & shard : _shards) {
+				lock_guard<mutex> guard(shard.guard);
+				for (auto & l : shard.locks) {
+					l.second->cancel();
+				}
+			}
+		}
+
+		LockTable::Shard & LockTable::_shard(uint64_t lockID)
+		{
+			// mix high bits into the shard index, evm programs often use strided IDs
+			uint64_t hash = lockID * 0x9e3779b97f4a7c15u;
+			return _shards[(hash >> 58) & (SHARD_COUNT - 1)];
+		}
+	}
+}
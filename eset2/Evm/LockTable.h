@@ -0,0 +1,88 @@
+//! @file	LockTable.h
+//! @author	agent
+//! @date	10.2026
+//! @brief	LockTable class declaration
+//!
+//! LockTable is a concurrent directory of evm locks. Evm programs identify locks
+//! by 64-bit IDs and create them implicitly on first use, possibly from many threads
+//! at once. Small IDs (the usual case, e.g. philosophers uses 0..N) are served from
+//! a preallocated dense array without hashing. Larger IDs go to a sharded hash map,
+//! where lock objects are created lazily and never move once created.
+#pragma once
+
+#include "stdafx.h"
+#include "Lock.h"
+
+namespace Evm {
+	namespace Utils {
+		//! @brief Concurrent lock directory
+		//!
+		//! Thread safe map from lock ID to lock object. References returned by
+		//! get() and find() stay valid for the lifetime of the table.
+		//! All locks in the table are of the same @ref LockPolicy.
+		struct LockTable {
+			using Lock = ILock;
+
+			static constexpr uint64_t DENSE_LOCK_COUNT = 1024;	//!< IDs below this value use the dense array
+			static constexpr size_t SHARD_COUNT = 64;			//!< Number of hash map shards (power of 2)
+
+			//! @brief Constructor
+			//!
+			//! Preallocates the dense part of the table
+			//! @param policy Implementation of the locks
+			//! @param collectWaitTimes True if locks should collect wait time histograms
+			LockTable(LockPolicy policy, bool collectWaitTimes);
+
+			//! @brief Get a lock
+			//!
+			//! Return the lock with given ID. When the lock doesn't exist it is created.
+			//! @param lockID ID of the lock
+			//! @return Reference to the lock
+			Lock & get(uint64_t lockID);
+
+			//! @brief Find a lock
+			//!
+			//! Return the lock with given ID, but only if it has been created by get() before.
+			//! @param lockID ID of the lock
+			//! @return Pointer to the lock or nullptr if the lock doesn't exist
+			Lock * find(uint64_t lockID);
+
+			//! @brief Get contention counters
+			//!
+			//! Sum of counters of all locks created so far.
+			//! @note Call it when evm threads are done
+			LockStatistics statistics();
+
+			//! @brief Cancel all locks
+			//!
+			//! Cancel locks created so far and locks created from now on. Threads waiting
+			//! for evm locks return immediately. Used at shutdown.
+			void cancel();
+
+			LockTable(const LockTable &) = delete;
+			LockTable & operator=(const LockTable &) = delete;
+
+		private:
+			//! Dense table entry
+			struct DenseSlot {
+				LockPtr lock;				//!< The lock
+				atomic<bool> used{ false };	//!< True if the lock has been obtained at least once
+			};
+
+			//! Hash map shard. Aligned to cache line so shards don't share lines.
+			struct alignas(64) Shard {
+				mutex guard;								//!< Protects the map, not the locks
+				unordered_map<uint64_t, LockPtr> locks;	//!< Lazily created locks
+			};
+
+			const LockPolicy _policy;			//!< Implementation of the locks
+			const bool _collectWaitTimes;		//!< Locks collect wait time histograms
+			unique_ptr<DenseSlot[]> _dense;		//!< Locks with ID < DENSE_LOCK_COUNT
+			array<Shard, SHARD_COUNT> _shards;	//!< Locks with ID >= DENSE_LOCK_COUNT
+			atomic<bool> _isCancelled{ false };	//!< True if the locks have been cancelled
+
+			//! @brief Helper function. Select shard for given lock ID
+			Shard & _shard(uint64_t lockID);
+		};
+	}
+}
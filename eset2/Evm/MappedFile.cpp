@@ -0,0 +1,106 @@
+//! @file	MappedFile.cpp
+//! @author	agent
+//! @date	10.2026
+//! @brief	MappedFile class definition
+#include "stdafx.h"
+#include "MappedFile.h"
+#include "RuntimeError.h"
+
+namespace Evm {
+	namespace Utils {
+		MappedFile::MappedFile(unique_ptr<PositionalFile> file) :
+			_file{ move(file) }
+		{
+			// the logical size is taken before mapping, the mapping may extend the file
+			auto size = Platform::fileSize(_file->handle());
+			_mapping = static_cast<Byte *>(Platform::mapFile(_file->handle(), Platform::FILE_MAPPING_RESERVE));
+			auto capacity = Platform::fileSize(_file->handle());
+			if (size < 0 || capacity < 0 || _mapping == nullptr) {
+				if (_mapping != nullptr) {
+					Platform::unmapFile(_mapping, Platform::FILE_MAPPING_RESERVE);
+				}
+				throw InputFileRuntimeError{ name(), "Unable to map" };
+			}
+			_size = static_cast<uint64_t>(size);
+			_capacity = static_cast<uint64_t>(capacity);
+		}
+
+		MappedFile::~MappedFile()
+		{
+			flush();
+			Platform::unmapFile(_mapping, Platform::FILE_MAPPING_RESERVE);
+			Platform::resizeFile(_file->handle(), _size);
+		}
+
+		uint64_t MappedFile::read(uint64_t offset, Byte * data, uint64_t size)
+		{
+			const uint64_t reserve = Platform::FILE_MAPPING_RESERVE;
+			uint64_t fileSize = _size.load(memory_order_acquire);
+			if (offset >= fileSize) {
+				return 0;
+			}
+			size = min(size, fileSize - offset);
+
+			uint64_t mapped = (offset < reserve) ? min(size, reserve - offset) : 0;
+			memcpy(data, _mapping + offset, static_cast<size_t>(mapped));
+			if (mapped == size) {
+				return size;
+			}
+			return mapped + _file->read(offset + mapped, data + mapped, size - mapped);
+		}
+
+		bool MappedFile::write(uint64_t offset, const Byte * data, uint64_t size)
+		{
+			const uint64_t reserve = Platform::FILE_MAPPING_RESERVE;
+			if (size > numeric_limits<uint64_t>::max() - offset) {
+				return false;
+			}
+
+			// data beyond the mapping are written only when the mapped part of the file
+			// has its full size, growth of the mapped part must not truncate them
+			uint64_t mapped = (offset < reserve) ? min(size, reserve - offset) : 0;
+			if (!_grow((mapped == size) ? offset + size : reserve)) {
+				return false;
+			}
+			memcpy(_mapping + offset, data, static_cast<size_t>(mapped));
+			if (mapped != size && !_file->write(offset + mapped, data + mapped, size - mapped)) {
+				return false;
+			}
+			_extend(offset + size);
+			return true;
+		}
+
+		bool MappedFile::flush()
+		{
+			const uint64_t reserve = Platform::FILE_MAPPING_RESERVE;
+			return Platform::flushMappedFile(_mapping, min(_capacity.load(), reserve));
+		}
+
+		bool MappedFile::_grow(uint64_t end)
+		{
+			if (end <= _capacity.load(memory_order_acquire)) {
+				return true;
+			}
+
+			lock_guard<mutex> lock(_growGuard);
+			uint64_t capacity = _capacity.load(memory_order_relaxed);
+			if (end <= capacity) {
+				return true;
+			}
+			uint64_t newCapacity = max(max(end, capacity * 2), static_cast<uint64_t>(MIN_CAPACITY));
+			newCapacity = max(min(newCapacity, static_cast<uint64_t>(Platform::FILE_MAPPING_RESERVE)), end);
+			if (!Platform::resizeFile(_file->handle(), newCapacity)) {
+				return false;
+			}
+			_capacity.store(newCapacity, memory_order_release);
+			return true;
+		}
+
+		void MappedFile::_extend(uint64_t end)
+		{
+			uint64_t size = _size.load(memory_order_relaxed);
+			while (end > size && !_size.compare_exchange_weak(size, end, memory_order_release, memory_order_relaxed)) {
+			}
+		}
+	}
+}
@@ -0,0 +1,69 @@
+//! @file	MappedFile.h
+//! @author	agent
+//! @date	10.2026
+//! @brief	MappedFile class declaration
+//!
+//! MappedFile maps the user file shared into the address space once, with a mapping
+//! (Platform::FILE_MAPPING_RESERVE) that is longer than the file. Reads and writes
+//! are bounds checked memcpys. When a write goes past the physical end of the file,
+//! the file is extended with ftruncate in geometric steps, so a sequence of small
+//! writes needs a logarithmic number of system calls. The logical size (the greatest
+//! written end) is tracked separately, the file is truncated to it and dirty pages
+//! are written back with msync when the file is closed.
+//! Data beyond the mapping is transferred with positional calls, the page cache is
+//! shared, so both paths see the same data.
+#pragma once
+
+#include "stdafx.h"
+#include "InputFile.h"
+#include "PositionalFile.h"
+
+namespace Evm {
+	namespace Utils {
+		//! @brief Memory mapped file
+		struct MappedFile : IFile {
+			static constexpr uint64_t MIN_CAPACITY = 1 << 16;	//!< The first step of file growth
+
+			//! @brief Constructor
+			//!
+			//! Map the file
+			//! @param file The file, opened for writing
+			//! @throw InputFileRuntimeError
+			MappedFile(unique_ptr<PositionalFile> file);
+
+			//! @brief Destructor
+			//!
+			//! Flush dirty pages, unmap the file and truncate it to its logical size
+			~MappedFile() override;
+
+			uint64_t read(uint64_t offset, Byte * data, uint64_t size) override;
+
+			bool write(uint64_t offset, const Byte * data, uint64_t size) override;
+
+			//! @brief Write dirty pages back with msync
+			bool flush() override;
+
+			uint64_t size() override {
+				return _size.load(memory_order_acquire);
+			}
+
+			const string & name() const override {
+				return _file->name();
+			}
+
+		private:
+			unique_ptr<PositionalFile> _file;	//!< The file, also serves data beyond the mapping
+			Byte * _mapping = nullptr;		//!< The mapping, Platform::FILE_MAPPING_RESERVE bytes
+			atomic<uint64_t> _size;			//!< Logical size of the file
+			atomic<uint64_t> _capacity;		//!< Physical size of the file, valid part of the mapping
+			mutex _growGuard;				//!< Serializes file growth
+
+			//! @brief Helper function. Extend the file, so that @ref end is in the valid part of the mapping
+			//! @return True on success
+			bool _grow(uint64_t end);
+
+			//! @brief Helper function. Move the logical end of the file to @ref end if it is greater
+			void _extend(uint64_t end);
+		};
+	}
+}
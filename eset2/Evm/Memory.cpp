@@ -42,14 +42,26 @@ namespace Evm {
 			return res;
 		}
 
-		bool Memory::_outOfMemory(uint64_t address, uint64_t size) const
+		const Byte * Memory::readableBlock(uint64_t address, uint64_t size) const
 		{
-			if ((address + size) > _memory.size()) {
-				return true;
+			if (_outOfMemory(address, size)) {
+				throw out_of_range("Reading beyound memory. Memory size :" +
+					to_string(_memory.size()) + " address: " + to_string(address) +
+					" size: " + to_string(size));
 			}
-			else {
-				return false;
+
+			return _memory.data() + address;
+		}
+
+		Byte * Memory::writableBlock(uint64_t address, uint64_t size)
+		{
+			if (_outOfMemory(address, size)) {
+				throw out_of_range("Writing beyound memory. Memory size :" +
+					to_string(_memory.size()) + " address: " + to_string(address) +
+					" size: " + to_string(size));
 			}
+
+			return _memory.data() + address;
 		}
 	}
 }
\ No newline at end of file
@@ -46,9 +46,92 @@ namespace Evm {
 			//! @throw out_of_range
 			Bytes read(uint64_t address, uint64_t size) const;
 
+			//! @brief Get readable data block
+			//!
+			//! Bounds checked access to @ref size bytes under @ref address without a copy,
+			//! for bulk transfers like file writes.
+			//! @param address Address in memory
+			//! @param size Number of bytes
+			//! @return Pointer to the first byte
+			//! @throw out_of_range
+			const Byte * readableBlock(uint64_t address, uint64_t size) const;
+
+			//! @brief Get writable data block
+			//!
+			//! Bounds checked access to @ref size bytes under @ref address without a copy,
+			//! for bulk transfers like file reads.
+			//! @param address Address in memory
+			//! @param size Number of bytes
+			//! @return Pointer to the first byte
+			//! @throw out_of_range
+			Byte * writableBlock(uint64_t address, uint64_t size);
+
+			//! @brief Load scalar value
+			//!
+			//! Fast path of instruction arguments, no allocation and no exception.
+			//! Bytes are in host order, the value is zero extended.
+			//! @param address Address in memory
+			//! @param size Number of bytes (1, 2, 4 or 8)
+			//! @param value Output, loaded value
+			//! @return False if the range is beyond the memory
+			bool load(uint64_t address, uint64_t size, uint64_t & value) const {
+				if (_outOfMemory(address, size)) {
+					return false;
+				}
+				value = 0;
+				memcpy(&value, _memory.data() + address, static_cast<size_t>(size));
+				return true;
+			}
+
+			//! @brief Store scalar value
+			//!
+			//! Fast path of instruction arguments, no allocation and no exception.
+			//! The lowest @ref size bytes of the value are stored in host order.
+			//! @param address Address in memory
+			//! @param size Number of bytes (1, 2, 4 or 8)
+			//! @param value Value to store
+			//! @return False if the range is beyond the memory
+			bool store(uint64_t address, uint64_t size, uint64_t value) {
+				if (_outOfMemory(address, size)) {
+					return false;
+				}
+				memcpy(_memory.data() + address, &value, static_cast<size_t>(size));
+				return true;
+			}
+
+			//! @brief Load scalar value without bounds check
+			//!
+			//! For accesses proven in range by static analysis
+			//! @param address Address in memory
+			//! @param size Number of bytes (1, 2, 4 or 8)
+			//! @return Loaded value, zero extended
+			uint64_t loadUnchecked(uint64_t address, uint64_t size) const {
+				uint64_t value = 0;
+				memcpy(&value, _memory.data() + address, static_cast<size_t>(size));
+				return value;
+			}
+
+			//! @brief Store scalar value without bounds check
+			//!
+			//! For accesses proven in range by static analysis
+			//! @param address Address in memory
+			//! @param size Number of bytes (1, 2, 4 or 8)
+			//! @param value Value to store
+			void storeUnchecked(uint64_t address, uint64_t size, uint64_t value) {
+				memcpy(_memory.data() + address, &value, static_cast<size_t>(size));
+			}
+
+			//! @brief Get memory size in bytes
+			uint64_t size() const {
+				return _memory.size();
+			}
+
 		private:
 			Bytes _memory;		//!< Memory
-			bool _outOfMemory(uint64_t address, uint64_t size) const;
+			bool _outOfMemory(uint64_t address, uint64_t size) const {
+				// written without address + size, the sum may overflow
+				return address > _memory.size() || size > _memory.size() - address;
+			}
 		};
 	}
 }
\ No newline at end of file
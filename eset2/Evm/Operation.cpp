@@ -9,77 +9,114 @@
 
 namespace Evm {
 	namespace Operation {
-		void MathOperation::execute(ThreadContext & thread) {
+		void IOperation::execute(ThreadContext & /*thread*/) {
+			throw NotImplementedOperationRuntimeError{};
+		}
+
+		Fault IOperation::run(ThreadContext & thread) {
+			try {
+				execute(thread);
+			}
+			catch (RuntimeError & e) {
+				return thread.raise(e);
+			}
+			catch (out_of_range & e) {
+				// Memory::read() and write() of I/O operations
+				string msg{ e.what() };
+				return thread.raise(DataMemoryOutOfRangeRuntimeError{ msg });
+			}
+			return Fault::None;
+		}
+
+		Fault MathOperation::run(ThreadContext & thread) {
 			// Get arguments, convert them to signed numbers
-			uint64_t arg1Value = _argList.at(0)->getValue(thread);
-			uint64_t arg2Value = _argList.at(1)->getValue(thread);
+			uint64_t arg1Value, arg2Value;
+			Fault fault = _argList[0]->load(thread, arg1Value);
+			if (fault != Fault::None) {
+				return fault;
+			}
+			fault = _argList[1]->load(thread, arg2Value);
+			if (fault != Fault::None) {
+				return fault;
+			}
 			int64_t arg1Signed = *reinterpret_cast<int64_t *>(&arg1Value);
 			int64_t arg2Signed = *reinterpret_cast<int64_t *>(&arg2Value);
 
 			// compute math operation, convert back to usigned
 			int64_t result = _mathOperation(arg1Signed, arg2Signed);
 			uint64_t resultUnsigned = *reinterpret_cast<uint64_t *>(&result);
-			_argList.at(2)->setValue(thread, resultUnsigned);
+			return _argList[2]->store(thread, resultUnsigned);
 		}
 
-		void MovOperation::execute(ThreadContext & thread) {
-			auto arg1Value = _argList.at(0)->getValue(thread);
-			_argList.at(1)->setValue(thread, arg1Value);
+		Fault MovOperation::run(ThreadContext & thread) {
+			uint64_t arg1Value;
+			Fault fault = _argList[0]->load(thread, arg1Value);
+			if (fault != Fault::None) {
+				return fault;
+			}
+			return _argList[1]->store(thread, arg1Value);
 		}
 
-		void LoadConstOperation::execute(ThreadContext & thread) {
-			uint64_t constValue = _argList.at(0)->getValue(thread);
-			_argList.at(1)->setValue(thread, constValue);
+		Fault LoadConstOperation::run(ThreadContext & thread) {
+			uint64_t constValue;
+			_argList[0]->load(thread, constValue);
+			return _argList[1]->store(thread, constValue);
 		}
 
 		void ConsoleWriteOperation::execute(ThreadContext & thread) {
-			static mutex sem;
-
-			{
-				// mutex protection of console output.
-				lock_guard<mutex> lock(sem);
-
-				uint64_t value = _argList.at(0)->getValue(thread);
-				ios_base::fmtflags flags{ cout.flags() };
-				cout << "0x" << setfill('0') << setw(16) << hex << value << "\n";
-				cout.flags(flags);
-			}
+			thread.consoleWrite(_argList.at(0)->getValue(thread));
 		}
 
 		void ConsoleReadOperation::execute(ThreadContext & thread) {
-			uint64_t input;
-			ios_base::fmtflags flags{ cin.flags() };
-			cin >> hex >> input;
-			cin.flags(flags);
-			_argList.at(0)->setValue(thread, input);
+			_argList.at(0)->setValue(thread, thread.application()->consoleInput().read());
 		}
 
-		void JumpOperation::execute(ThreadContext & thread) {
-			uint32_t address = static_cast<uint32_t>(_argList.at(0)->getValue(thread));
-			thread.programCounter(address);
+		Fault JumpOperation::run(ThreadContext & thread) {
+			uint64_t address;
+			_argList[0]->load(thread, address);
+			thread.core().programCounter = static_cast<uint32_t>(address);
+			return Fault::None;
 		}
 
-		void CallOperation::execute(ThreadContext & thread) {
-			uint32_t address = static_cast<uint32_t>(_argList.at(0)->getValue(thread));
-			thread.push(thread.programCounter());
-			thread.programCounter(address);
+		Fault CallOperation::run(ThreadContext & thread) {
+			uint64_t address;
+			_argList[0]->load(thread, address);
+			auto & core = thread.core();
+			if (!core.callStack.push(core.programCounter)) {
+				return thread.raise(Fault::StackOverflow, 0, 0, core.callStack.maxDepth());
+			}
+			core.programCounter = static_cast<uint32_t>(address);
+			return Fault::None;
 		}
 
-		void HltOperation::execute(ThreadContext & thread) {
+		Fault HltOperation::run(ThreadContext & thread) {
 			thread.terminate();
+			return Fault::None;
 		}
 
-		void RetOperation::execute(ThreadContext & thread) {
-			thread.programCounter(thread.pop());
+		Fault RetOperation::run(ThreadContext & thread) {
+			auto & core = thread.core();
+			if (!core.callStack.pop(core.programCounter)) {
+				return thread.raise(Fault::StackUnderflow);
+			}
+			return Fault::None;
 		}
 
-		void JumpEqualOperation::execute(ThreadContext & thread) {
-			uint32_t address = static_cast<uint32_t>(_argList.at(0)->getValue(thread));
-			auto arg1Value = _argList.at(1)->getValue(thread);
-			auto arg2Value = _argList.at(2)->getValue(thread);
+		Fault JumpEqualOperation::run(ThreadContext & thread) {
+			uint64_t address, arg1Value, arg2Value;
+			_argList[0]->load(thread, address);
+			Fault fault = _argList[1]->load(thread, arg1Value);
+			if (fault != Fault::None) {
+				return fault;
+			}
+			fault = _argList[2]->load(thread, arg2Value);
+			if (fault != Fault::None) {
+				return fault;
+			}
 			if (arg1Value == arg2Value) {
-				thread.programCounter(address);
+				thread.core().programCounter = static_cast<uint32_t>(address);
 			}
+			return Fault::None;
 		}
 
 		void CreateThreadOperation::execute(ThreadContext & thread) {
@@ -90,7 +127,7 @@ namespace Evm {
 
 		void JoinOperation::execute(ThreadContext & thread) {
 			uint64_t threadId = _argList.at(0)->getValue(thread);
-			thread.application()->joinThread(threadId);
+			thread.application()->joinThread(thread, threadId);
 		}
 
 		void SleepOperation::execute(ThreadContext & thread) {
@@ -100,7 +137,7 @@ namespace Evm {
 
 		void LockOperation::execute(ThreadContext & thread) {
 			uint64_t lockID = _argList.at(0)->getValue(thread);
-			thread.application()->lock(lockID);
+			thread.application()->lock(thread, lockID);
 		}
 
 		void UnlockOperation::execute(ThreadContext & thread) {
@@ -109,28 +146,22 @@ namespace Evm {
 		}
 
 		void WriteOperation::execute(ThreadContext & thread) {
-			static mutex sem;
-
-			{
-				// mutex protection of file.
-				// In my opinion this is a shared resource and should be protected by
-				// by locks in user application. However I decided to implement the lock to achieve good
-				// execution of multithreaded_file_write.evm example
-				lock_guard<mutex> lock(sem);
-				auto offset = _argList.at(0)->getValue(thread);
-				auto numOfBytes = _argList.at(1)->getValue(thread);
-				auto memoryAddress = _argList.at(2)->getValue(thread);
-				auto & file = thread.application()->inputFile();
-				auto & memory = thread.application()->dataMemory();
-
-				Bytes dataToWrite = memory.read(memoryAddress, numOfBytes);
+			// positional write without a lock, the file is a shared resource and
+			// overlapping writes should be ordered by locks in the user application
+			auto offset = _argList.at(0)->getValue(thread);
+			auto numOfBytes = _argList.at(1)->getValue(thread);
+			auto memoryAddress = _argList.at(2)->getValue(thread);
+			auto & memory = thread.application()->dataMemory();
 
-				file.seekp(offset);
-				file.write(reinterpret_cast<const char *>(dataToWrite.data()), dataToWrite.size());
-				if (!file.good()) {
-					throw InputFileRuntimeError{ thread.application()->inputFileName(), "Unable to write. Offset: " + to_string(offset) +
-						" address: " + to_string(memoryAddress) + " bytes: " + to_string(numOfBytes) };
-				}
+			const Byte * dataToWrite = memory.readableBlock(memoryAddress, numOfBytes);
+			uint64_t bytesWritten;
+			if (!thread.writeFile(offset, dataToWrite, numOfBytes, bytesWritten)) {
+				return;
+			}
+			if (bytesWritten != numOfBytes) {
+				auto & file = thread.file(Utils::IoRequest::Type::Write);
+				throw InputFileRuntimeError{ file.name(), "Unable to write. Offset: " + to_string(offset) +
+					" address: " + to_string(memoryAddress) + " bytes: " + to_string(numOfBytes) };
 			}
 		}
 
@@ -138,15 +169,53 @@ namespace Evm {
 			auto offset = _argList.at(0)->getValue(thread);
 			auto numOfBytes = _argList.at(1)->getValue(thread);
 			auto memoryAddress = _argList.at(2)->getValue(thread);
-			auto & file = thread.application()->inputFile();
 			auto & memory = thread.application()->dataMemory();
 
-			Bytes dataBuffer(numOfBytes);
+			// pread straight into data memory, bytes beyond the end of the file are left unchanged
+			Byte * dataBuffer = memory.writableBlock(memoryAddress, numOfBytes);
+			uint64_t bytesRead;
+			if (!thread.readFile(offset, dataBuffer, numOfBytes, bytesRead)) {
+				return;
+			}
+			_argList.at(3)->setValue(thread, bytesRead);
+		}
+
+		void OpenOperation::execute(ThreadContext & thread) {
+			auto index = _argList.at(0)->getValue(thread);
+			_argList.at(1)->setValue(thread, thread.application()->fileTable().open(index));
+		}
+
+		void CloseOperation::execute(ThreadContext & thread) {
+			auto handle = _argList.at(0)->getValue(thread);
+			thread.application()->fileTable().close(handle);
+		}
+
+		void SizeOperation::execute(ThreadContext & thread) {
+			auto handle = _argList.at(0)->getValue(thread);
+			auto application = thread.application();
+			uint64_t size = (handle == Utils::FileTable::USER_FILES) ? application->inputFile().size() :
+				application->fileTable().get(handle)->size();
+			_argList.at(1)->setValue(thread, size);
+		}
+
+		void UseFileOperation::execute(ThreadContext & thread) {
+			thread.useFile(_argList.at(0)->getValue(thread));
+		}
 
-			file.seekg(offset);
-			file.read(reinterpret_cast<char *>(dataBuffer.data()), dataBuffer.size());
-			auto bytesRead = file.gcount();
-			_argList.at(3)->setValue(thread, static_cast<uint64_t>(bytesRead));
+		bool IOperation::target(uint32_t & address) const
+		{
+			auto flow = controlFlow();
+			if (flow != ControlFlow::Jump && flow != ControlFlow::Branch && flow != ControlFlow::Call &&
+				flow != ControlFlow::Spawn) {
+				return false;
+			}
+
+			uint64_t value;
+			if (_argList.empty() || !_argList[0]->constValue(value)) {
+				return false;
+			}
+			address = static_cast<uint32_t>(value);
+			return true;
 		}
 
 		ostream & operator<<(ostream & os, IOperation & op)
@@ -12,6 +12,9 @@
 //! function to get string with instruction opcode, printable list of arguments
 //! and values of the arguments. Abstraction capable of making the Operations is
 //! @ref IOperationFactory
+//! The interpreter loop calls run(), which returns a @ref Fault code instead of throwing.
+//! Simple operations implement run() directly, the ones that block or do I/O
+//! implement execute() and their RuntimeErrors are converted to faults.
 #pragma once
 
 #include "stdafx.h"
@@ -31,12 +34,39 @@ namespace Evm {
 		using ArgumentPtr = unique_ptr<Argument::IArgument>;
 		using ArgumentList = vector<ArgumentPtr>;
 
+		//! @brief Effect of an operation on the program counter
+		//!
+		//! Used by the program verifier to build the control flow graph
+		enum class ControlFlow {
+			Next,		//!< Continue with the next instruction
+			Jump,		//!< Continue at the target
+			Branch,		//!< Continue at the target or with the next instruction
+			Call,		//!< Continue at the target, return to the next instruction
+			Return,		//!< Continue at an address from the call stack
+			Halt,		//!< End the thread
+			Spawn		//!< Continue with the next instruction, a new thread starts at the target
+		};
+
+		//! @brief Value written to the destination argument, used by static analysis
+		enum class DataFlow {
+			Other,		//!< Not modeled or nothing is written
+			Copy,		//!< The first argument
+			Add,		//!< Sum of the first two arguments
+			Sub,		//!< Difference of the first two arguments
+			Mul,		//!< Product of the first two arguments
+			Div,		//!< Quotient of the first two arguments
+			Mod,		//!< Remainder of the first two arguments
+			Compare		//!< Sign of difference of the first two arguments
+		};
+
 		//! @brief IOperation interface. Abstraction of Evm instruction
 		//!
 		//! The class represents an Evm instruction. It provides three API methods,
 		//! execute() - to run the operaction, trace() - to get printable representation
 		//! and current values of arguemnts, and pushArgument() - to assign arguments.
 		struct IOperation {
+			static constexpr size_t NO_DESTINATION = numeric_limits<size_t>::max();	//!< See destination()
+
 			//! @brief Constructor
 			//!
 			//! @param opcode Printable label of the instruction
@@ -50,8 +80,62 @@ namespace Evm {
 			//! May by call by an application to execute the operation.
 			//! The execution requires to be awared of thread context
 			//! within the operation is executed.
+			//! Operations that override run() don't need it, by default it throws
+			//! NotImplementedOperationRuntimeError.
+			//! @note An operation overrides execute(), run() or both
+			//! @param thread Context of Evm thread
+			//! @throw RuntimeError
+			virtual void execute(ThreadContext & thread);
+
+			//! @brief Execution of the instruction without exceptions
+			//!
+			//! Used by the interpreter loop. By default it runs execute() and
+			//! records a thrown RuntimeError as a fault.
 			//! @param thread Context of Evm thread
-			virtual void execute(ThreadContext & thread) = 0;
+			//! @return Fault::None or the fault recorded in the thread
+			virtual Fault run(ThreadContext & thread);
+
+			//! @brief Get effect on the program counter
+			//!
+			//! @return ControlFlow::Next for operations that don't transfer control
+			virtual ControlFlow controlFlow() const {
+				return ControlFlow::Next;
+			}
+
+			//! @brief Get value written to the destination argument
+			//!
+			//! @return DataFlow::Other for operations that aren't modeled
+			virtual DataFlow dataFlow() const {
+				return DataFlow::Other;
+			}
+
+			//! @brief Get argument written by the operation
+			//!
+			//! @return Index of the destination argument, NO_DESTINATION if no argument is written
+			virtual size_t destination() const {
+				return NO_DESTINATION;
+			}
+
+			//! @brief Get target address of control transfer
+			//!
+			//! The target is the first argument of jump, jumpEqual, call and createThread
+			//! @param address Output, the target address
+			//! @return False if the operation has no static target
+			bool target(uint32_t & address) const;
+
+			//! @brief Get arguments of the operation
+			const ArgumentList & arguments() const {
+				return _argList;
+			}
+
+			//! @brief Replace an argument
+			//!
+			//! Used by Program to install arguments specialized by static analysis
+			//! @param index Index of the argument
+			//! @param arg The new argument, it must have the same meaning
+			void replaceArgument(size_t index, ArgumentPtr arg) {
+				_argList.at(index) = move(arg);
+			}
 
 			//! @brief Assign argument to the operation
 			//!
@@ -97,13 +181,22 @@ namespace Evm {
 			//!
 			//! @param opcode Printable label of the instruction
 			//! @param function Lambde with the essental operation
-			MathOperation(string & opcode, function<int64_t(int64_t, int64_t)> mathOperation) :
+			//! @param dataFlow The function for static analysis
+			MathOperation(string & opcode, function<int64_t(int64_t, int64_t)> mathOperation, DataFlow dataFlow) :
 				IOperation{ opcode },
-				_mathOperation{ mathOperation }
+				_mathOperation{ mathOperation },
+				_dataFlow{ dataFlow }
 			{}
-			virtual void execute(ThreadContext & thread) override;
+			virtual Fault run(ThreadContext & thread) override;
+			virtual DataFlow dataFlow() const override {
+				return _dataFlow;
+			}
+			virtual size_t destination() const override {
+				return 2;
+			}
 		private:
 			function<int64_t(int64_t, int64_t)> _mathOperation;
+			DataFlow _dataFlow;
 		};
 
 		//! @brief mov operation
@@ -111,7 +204,13 @@ namespace Evm {
 		//! mov arg1, arg2;	arg2 <- arg1
 		struct MovOperation : IOperation {
 			using IOperation::IOperation;
-			virtual void execute(ThreadContext & thread) override;
+			virtual Fault run(ThreadContext & thread) override;
+			virtual DataFlow dataFlow() const override {
+				return DataFlow::Copy;
+			}
+			virtual size_t destination() const override {
+				return 1;
+			}
 		};
 
 		//! @brief loadConst operation
@@ -119,7 +218,13 @@ namespace Evm {
 		//! loadConst constant,	arg1; arg1 <-constant
 		struct LoadConstOperation : IOperation {
 			using IOperation::IOperation;
-			virtual void execute(ThreadContext & thread) override;
+			virtual Fault run(ThreadContext & thread) override;
+			virtual DataFlow dataFlow() const override {
+				return DataFlow::Copy;
+			}
+			virtual size_t destination() const override {
+				return 1;
+			}
 		};
 
 		//! @brief consoleWrite operation
@@ -136,6 +241,9 @@ namespace Evm {
 		struct ConsoleReadOperation : IOperation {
 			using IOperation::IOperation;
 			virtual void execute(ThreadContext & thread) override;
+			virtual size_t destination() const override {
+				return 0;
+			}
 		};
 
 		//! @brief call operation
@@ -144,7 +252,10 @@ namespace Evm {
 		//! continue execution at address
 		struct CallOperation : IOperation {
 			using IOperation::IOperation;
-			virtual void execute(ThreadContext & thread) override;
+			virtual Fault run(ThreadContext & thread) override;
+			virtual ControlFlow controlFlow() const override {
+				return ControlFlow::Call;
+			}
 		};
 
 		//! @brief jump operation
@@ -152,7 +263,10 @@ namespace Evm {
 		//! jump address; Move instruction pointer to address
 		struct JumpOperation : IOperation {
 			using IOperation::IOperation;
-			virtual void execute(ThreadContext & thread) override;
+			virtual Fault run(ThreadContext & thread) override;
+			virtual ControlFlow controlFlow() const override {
+				return ControlFlow::Jump;
+			}
 		};
 
 		//! @brief hlt operation
@@ -161,7 +275,10 @@ namespace Evm {
 		//! program.
 		struct HltOperation : IOperation {
 			using IOperation::IOperation;
-			virtual void execute(ThreadContext & thread) override;
+			virtual Fault run(ThreadContext & thread) override;
+			virtual ControlFlow controlFlow() const override {
+				return ControlFlow::Halt;
+			}
 		};
 
 		//! @brief ret operation
@@ -169,7 +286,10 @@ namespace Evm {
 		//! ret; Take address from internal stack and continue execution from it
 		struct RetOperation : IOperation {
 			using IOperation::IOperation;
-			virtual void execute(ThreadContext & thread) override;
+			virtual Fault run(ThreadContext & thread) override;
+			virtual ControlFlow controlFlow() const override {
+				return ControlFlow::Return;
+			}
 		};
 
 		//! @brief jumpEqual operation
@@ -178,7 +298,10 @@ namespace Evm {
 		//! Move instruction pointer to address if arg1 == arg2.
 		struct JumpEqualOperation : IOperation {
 			using IOperation::IOperation;
-			virtual void execute(ThreadContext & thread) override;
+			virtual Fault run(ThreadContext & thread) override;
+			virtual ControlFlow controlFlow() const override {
+				return ControlFlow::Branch;
+			}
 		};
 
 		//! @brief createThread operation
@@ -189,6 +312,12 @@ namespace Evm {
 		struct CreateThreadOperation : IOperation {
 			using IOperation::IOperation;
 			virtual void execute(ThreadContext & thread) override;
+			virtual ControlFlow controlFlow() const override {
+				return ControlFlow::Spawn;
+			}
+			virtual size_t destination() const override {
+				return 1;
+			}
 		};
 
 		//! @brief joinThread operation
@@ -250,6 +379,51 @@ namespace Evm {
 		struct ReadOperation : IOperation {
 			using IOperation::IOperation;
 			virtual void execute(ThreadContext & thread) override;
+			virtual size_t destination() const override {
+				return 3;
+			}
+		};
+
+		//! @brief open operation
+		//!
+		//! open arg1, arg2; Open file number arg1 of the manifest (the first line is 0),
+		//! arg2 receives handle of the file
+		struct OpenOperation : IOperation {
+			using IOperation::IOperation;
+			virtual void execute(ThreadContext & thread) override;
+			virtual size_t destination() const override {
+				return 1;
+			}
+		};
+
+		//! @brief close operation
+		//!
+		//! close arg1; Close file handle arg1
+		struct CloseOperation : IOperation {
+			using IOperation::IOperation;
+			virtual void execute(ThreadContext & thread) override;
+		};
+
+		//! @brief size operation
+		//!
+		//! size arg1, arg2; arg2 receives size of the file with handle arg1,
+		//! handle 0 is the input file
+		struct SizeOperation : IOperation {
+			using IOperation::IOperation;
+			virtual void execute(ThreadContext & thread) override;
+			virtual size_t destination() const override {
+				return 1;
+			}
+		};
+
+		//! @brief useFile operation
+		//!
+		//! useFile arg1; Following read and write operations of the current thread
+		//! access the file with handle arg1. Handle 0 selects the input and output files,
+		//! it is the initial selection of each thread.
+		struct UseFileOperation : IOperation {
+			using IOperation::IOperation;
+			virtual void execute(ThreadContext & thread) override;
 		};
 	}
 }
\ No newline at end of file
@@ -17,14 +17,15 @@ namespace Evm {
 			return res;
 		}
 
-		MathOperationFactory::MathOperationFactory(const string & opcode, const Utils::BitBuffer & programMemory, function<int64_t(int64_t, int64_t)> function) :
+		MathOperationFactory::MathOperationFactory(const string & opcode, const Utils::BitBuffer & programMemory, DataFlow dataFlow, function<int64_t(int64_t, int64_t)> function) :
 			IOperationFactory{ opcode, programMemory },
+			_dataFlow{ dataFlow },
 			_function{ function }
 		{}
 
 		OperationPtr MathOperationFactory::build(uint32_t & offset)
 		{
-			OperationPtr res = make_unique<MathOperation>(_opcode, _function);
+			OperationPtr res = make_unique<MathOperation>(_opcode, _function, _dataFlow);
 			res->pushArgument(Argument::getRegisterArgument(_programMemory, offset));
 			res->pushArgument(Argument::getRegisterArgument(_programMemory, offset));
 			res->pushArgument(Argument::getRegisterArgument(_programMemory, offset));
@@ -92,7 +93,7 @@ namespace Evm {
 				opcode = programMemory.getU32(offset, 5);
 				switch (opcode) {
 				case OPCODE_5BIT_COMPARE:
-					factory = make_unique<MathOperationFactory>("compare", programMemory,
+					factory = make_unique<MathOperationFactory>("compare", programMemory, DataFlow::Compare,
 						[](int64_t a, int64_t b) {
 								if (a < b) return -1;
 								else if (a == b) return 0;
@@ -129,6 +130,9 @@ namespace Evm {
 				case OPCODE_5BIT_SLEEP:
 					factory = make_unique<Arg1OperationFactory<SleepOperation>>("sleep", programMemory);
 					break;
+				case OPCODE_5BIT_USE_FILE:
+					factory = make_unique<Arg1OperationFactory<UseFileOperation>>("useFile", programMemory);
+					break;
 				}
 			}
 
@@ -138,25 +142,34 @@ namespace Evm {
 				opcode = programMemory.getU32(offset, 6);
 				switch (opcode) {
 				case OPCODE_6BIT_ADD:
-					factory = make_unique<MathOperationFactory>("add", programMemory, 
+					factory = make_unique<MathOperationFactory>("add", programMemory, DataFlow::Add, 
 						[](int64_t a, int64_t b) {return a + b; });
 					break;
 				case OPCODE_6BIT_SUB:
-					factory = make_unique<MathOperationFactory>("sub", programMemory, 
+					factory = make_unique<MathOperationFactory>("sub", programMemory, DataFlow::Sub, 
 						[](int64_t a, int64_t b) {return a - b; });
 					break;
 				case OPCODE_6BIT_DIV:
-					factory = make_unique<MathOperationFactory>("div", programMemory, 
+					factory = make_unique<MathOperationFactory>("div", programMemory, DataFlow::Div, 
 						[](int64_t a, int64_t b) {return a / b; });
 					break;
 				case OPCODE_6BIT_MOD:
-					factory = make_unique<MathOperationFactory>("mod", programMemory, 
+					factory = make_unique<MathOperationFactory>("mod", programMemory, DataFlow::Mod, 
 						[](int64_t a, int64_t b) {return a % b; });
 					break;
 				case OPCODE_6BIT_MUL:
-					factory = make_unique<MathOperationFactory>("mul", programMemory, 
+					factory = make_unique<MathOperationFactory>("mul", programMemory, DataFlow::Mul, 
 						[](int64_t a, int64_t b) {return a * b; });
 					break;
+				case OPCODE_6BIT_SIZE:
+					factory = make_unique<Arg1Arg2OperationFactory<SizeOperation>>("size", programMemory);
+					break;
+				case OPCODE_6BIT_OPEN:
+					factory = make_unique<Arg1Arg2OperationFactory<OpenOperation>>("open", programMemory);
+					break;
+				case OPCODE_6BIT_CLOSE:
+					factory = make_unique<Arg1OperationFactory<CloseOperation>>("close", programMemory);
+					break;
 				}
 			}
 
@@ -168,5 +181,24 @@ namespace Evm {
 			offset = tmpOffset;
 			return factory->build(offset);
 		}
+
+		OperationPtr tryMakeOperation(const Utils::BitBuffer & programMemory, uint32_t & offset, FaultRecord & fault)
+		{
+			// decoding is the only place of the loop that still throws, keep the conversion here
+			try {
+				return makeOperation(programMemory, offset);
+			}
+			catch (RuntimeError & e) {
+				fault = FaultRecord{};
+				fault.fault = Fault::RuntimeError;
+				fault.message = e.what();
+			}
+			catch (out_of_range & e) {
+				(void)e;
+				fault = FaultRecord{};
+				fault.fault = Fault::ProgramMemory;
+			}
+			return nullptr;
+		}
 }
 }
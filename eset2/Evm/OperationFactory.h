@@ -27,11 +27,15 @@ namespace Evm {
 		constexpr uint32_t OPCODE_5BIT_JOIN_THREAD		= 0x00000015;	//!< joinThread arg1					opcode 10101
 		constexpr uint32_t OPCODE_5BIT_HLT				= 0x00000016;	//!< hlt								opcode 10110
 		constexpr uint32_t OPCODE_5BIT_SLEEP			= 0x00000017;	//!< sleep arg1						opcode 10111
+		constexpr uint32_t OPCODE_5BIT_USE_FILE			= 0x0000000f;	//!< useFile arg1						opcode 01111
+		constexpr uint32_t OPCODE_6BIT_SIZE				= 0x00000010;	//!< size arg1, arg2					opcode 010000
 		constexpr uint32_t OPCODE_6BIT_ADD				= 0x00000011;	//!< add arg1, arg2, arg3				opcode 010001
 		constexpr uint32_t OPCODE_6BIT_SUB				= 0x00000012;	//!< sub arg1, arg2, arg3				opcode 010010
 		constexpr uint32_t OPCODE_6BIT_DIV				= 0x00000013;	//!< div arg1, arg2, arg3				opcode 010011
 		constexpr uint32_t OPCODE_6BIT_MOD				= 0x00000014;	//!< mod arg1, arg2, arg3				opcode 010100
 		constexpr uint32_t OPCODE_6BIT_MUL				= 0x00000015;	//!< mul arg1, arg2, arg3				opcode 010101
+		constexpr uint32_t OPCODE_6BIT_OPEN				= 0x00000016;	//!< open arg1, arg2					opcode 010110
+		constexpr uint32_t OPCODE_6BIT_CLOSE			= 0x00000017;	//!< close arg1						opcode 010111
 		
 		//! @brief IOperation factory intefrace
 		//!
@@ -185,10 +189,12 @@ namespace Evm {
 			//!
 			//! @param opcode Printable label of the instruction
 			//! @param programMemory Reference to program memory
+			//! @param dataFlow The math operation for static analysis
 			//! @param function Lambda with math operation
-			MathOperationFactory(const string & opcode, const Utils::BitBuffer & bb, function<int64_t(int64_t, int64_t)> function);
+			MathOperationFactory(const string & opcode, const Utils::BitBuffer & bb, DataFlow dataFlow, function<int64_t(int64_t, int64_t)> function);
 			OperationPtr build(uint32_t & offset);
 		private:
+			DataFlow _dataFlow;								//!< The math operation for static analysis
 			function<int64_t(int64_t, int64_t)> _function;	//!< Lambda with math operation
 		};
 
@@ -203,5 +209,14 @@ namespace Evm {
 		//!		required by the instruction
 		//! @return Object of IOperation interface
 		OperationPtr makeOperation(const Utils::BitBuffer & programMemory, uint32_t & offset);
+
+		//! @brief Opcode decoder without exceptions
+		//!
+		//! The same as makeOperation(), but decoding errors are returned as a fault
+		//! @param programMemory Reference to program memory
+		//! @param offset Input/output reference, see makeOperation()
+		//! @param fault Output, the fault if the instruction can't be decoded
+		//! @return Object of IOperation interface, nullptr on fault
+		OperationPtr tryMakeOperation(const Utils::BitBuffer & programMemory, uint32_t & offset, FaultRecord & fault);
 	}
 }
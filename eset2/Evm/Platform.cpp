@@ -0,0 +1,527 @@
+//! @file	Platform.cpp
+//! @author	agent
+//! @date	10.2026
+//! @brief	Operating system specific helpers
+#include "stdafx.h"
+#include "Platform.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#pragma comment(lib, "Synchronization.lib")
+#else
+#include <cerrno>
+#include <csignal>
+#include <sched.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace Evm {
+	namespace Platform {
+		static_assert(sizeof(atomic<uint32_t>) == sizeof(uint32_t), "futex word must be plain 32-bit value");
+
+#ifdef _WIN32
+		void * alignedAlloc(size_t size, size_t alignment)
+		{
+			return _aligned_malloc(size, alignment);
+		}
+
+		void alignedFree(void * memory)
+		{
+			_aligned_free(memory);
+		}
+#else
+		void * alignedAlloc(size_t size, size_t alignment)
+		{
+			void * memory = nullptr;
+			return (posix_memalign(&memory, alignment, size) == 0) ? memory : nullptr;
+		}
+
+		void alignedFree(void * memory)
+		{
+			free(memory);
+		}
+#endif
+
+#ifdef _WIN32
+		void futexWait(atomic<uint32_t> & address, uint32_t expected)
+		{
+			WaitOnAddress(&address, &expected, sizeof(expected), INFINITE);
+		}
+
+		void futexWakeOne(atomic<uint32_t> & address)
+		{
+			WakeByAddressSingle(&address);
+		}
+
+		void futexWakeAll(atomic<uint32_t> & address)
+		{
+			WakeByAddressAll(&address);
+		}
+
+		vector<CpuInfo> availableCpus()
+		{
+			DWORD_PTR processMask = 0;
+			DWORD_PTR systemMask = 0;
+			if (!GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask)) {
+				processMask = 1;
+			}
+
+			// topology - logical processor masks of cores and packages
+			vector<pair<ULONG_PTR, uint32_t>> cores;
+			vector<pair<ULONG_PTR, uint32_t>> packages;
+			DWORD length = 0;
+			GetLogicalProcessorInformation(nullptr, &length);
+			vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> info(length / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+			if (!info.empty() && GetLogicalProcessorInformation(info.data(), &length)) {
+				for (const auto & i : info) {
+					if (i.Relationship == RelationProcessorCore) {
+						cores.emplace_back(i.ProcessorMask, static_cast<uint32_t>(cores.size()));
+					}
+					else if (i.Relationship == RelationProcessorPackage) {
+						packages.emplace_back(i.ProcessorMask, static_cast<uint32_t>(packages.size()));
+					}
+				}
+			}
+
+			vector<CpuInfo> res;
+			for (uint32_t cpu = 0; cpu < sizeof(DWORD_PTR) * 8; cpu++) {
+				ULONG_PTR bit = ULONG_PTR{ 1 } << cpu;
+				if ((processMask & bit) == 0) {
+					continue;
+				}
+				CpuInfo c{ cpu, 0, cpu };
+				for (const auto & core : cores) {
+					if (core.first & bit) {
+						c.core = core.second;
+					}
+				}
+				for (const auto & package : packages) {
+					if (package.first & bit) {
+						c.package = package.second;
+					}
+				}
+				res.push_back(c);
+			}
+			return res;
+		}
+
+		bool setThreadAffinity(const vector<uint32_t> & cpus)
+		{
+			DWORD_PTR mask = 0;
+			for (auto cpu : cpus) {
+				if (cpu < sizeof(DWORD_PTR) * 8) {
+					mask |= DWORD_PTR{ 1 } << cpu;
+				}
+			}
+			return mask != 0 && SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+		}
+
+		int32_t currentCpu()
+		{
+			return static_cast<int32_t>(GetCurrentProcessorNumber());
+		}
+
+		FileHandle openFile(const string & fileName, FileAccess access)
+		{
+			DWORD desiredAccess = GENERIC_READ | GENERIC_WRITE;
+			DWORD disposition = OPEN_ALWAYS;
+			DWORD flags = FILE_ATTRIBUTE_NORMAL;
+			if (access == FileAccess::ReadSequential) {
+				desiredAccess = GENERIC_READ;
+				disposition = OPEN_EXISTING;
+				flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+			}
+			else if (access == FileAccess::Create) {
+				disposition = CREATE_ALWAYS;
+			}
+			else if (access == FileAccess::Update) {
+				disposition = OPEN_EXISTING;
+			}
+			else if (access == FileAccess::WriteSequential) {
+				desiredAccess = GENERIC_WRITE;
+				disposition = OPEN_EXISTING;
+			}
+			HANDLE file = CreateFileA(fileName.c_str(), desiredAccess,
+				FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, disposition, flags, nullptr);
+			return reinterpret_cast<FileHandle>(file);
+		}
+
+		void closeFile(FileHandle file)
+		{
+			CloseHandle(reinterpret_cast<HANDLE>(file));
+		}
+
+		//! @brief Helper function. OVERLAPPED structure that selects a file offset
+		static OVERLAPPED fileOffset(uint64_t offset)
+		{
+			OVERLAPPED overlapped{};
+			overlapped.Offset = static_cast<DWORD>(offset);
+			overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+			return overlapped;
+		}
+
+		int64_t readFileAt(FileHandle file, uint64_t offset, void * data, size_t size)
+		{
+			OVERLAPPED overlapped = fileOffset(offset);
+			DWORD transferred = 0;
+			DWORD chunk = (size < MAXDWORD) ? static_cast<DWORD>(size) : MAXDWORD;
+			if (!ReadFile(reinterpret_cast<HANDLE>(file), data, chunk, &transferred, &overlapped)) {
+				return (GetLastError() == ERROR_HANDLE_EOF) ? 0 : -1;
+			}
+			return transferred;
+		}
+
+		int64_t writeFileAt(FileHandle file, uint64_t offset, const void * data, size_t size)
+		{
+			OVERLAPPED overlapped = fileOffset(offset);
+			DWORD transferred = 0;
+			DWORD chunk = (size < MAXDWORD) ? static_cast<DWORD>(size) : MAXDWORD;
+			if (!WriteFile(reinterpret_cast<HANDLE>(file), data, chunk, &transferred, &overlapped)) {
+				return -1;
+			}
+			return transferred;
+		}
+
+		int64_t readFile(FileHandle file, void * data, size_t size)
+		{
+			DWORD transferred = 0;
+			DWORD chunk = (size < MAXDWORD) ? static_cast<DWORD>(size) : MAXDWORD;
+			if (!ReadFile(reinterpret_cast<HANDLE>(file), data, chunk, &transferred, nullptr)) {
+				// the writing end of a pipe is closed
+				return (GetLastError() == ERROR_BROKEN_PIPE) ? 0 : -1;
+			}
+			return transferred;
+		}
+
+		int64_t writeFile(FileHandle file, const void * data, size_t size)
+		{
+			DWORD transferred = 0;
+			DWORD chunk = (size < MAXDWORD) ? static_cast<DWORD>(size) : MAXDWORD;
+			if (!WriteFile(reinterpret_cast<HANDLE>(file), data, chunk, &transferred, nullptr)) {
+				return -1;
+			}
+			return transferred;
+		}
+
+		void ignoreBrokenPipe()
+		{
+		}
+
+		bool isSeekable(FileHandle file)
+		{
+			return GetFileType(reinterpret_cast<HANDLE>(file)) == FILE_TYPE_DISK;
+		}
+
+		//! @brief Helper function. Get volume and index of a file
+		static bool fileIdentity(const string & fileName, BY_HANDLE_FILE_INFORMATION & info)
+		{
+			// no access rights are needed to query the identity, directories need backup semantics
+			HANDLE file = CreateFileA(fileName.c_str(), 0, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+				nullptr, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS, nullptr);
+			if (file == INVALID_HANDLE_VALUE) {
+				return false;
+			}
+			bool res = GetFileInformationByHandle(file, &info) != 0;
+			CloseHandle(file);
+			return res;
+		}
+
+		bool isSameFile(const string & fileName1, const string & fileName2)
+		{
+			BY_HANDLE_FILE_INFORMATION info1, info2;
+			return fileIdentity(fileName1, info1) && fileIdentity(fileName2, info2) &&
+				info1.dwVolumeSerialNumber == info2.dwVolumeSerialNumber &&
+				info1.nFileIndexHigh == info2.nFileIndexHigh && info1.nFileIndexLow == info2.nFileIndexLow;
+		}
+
+		int64_t fileSize(FileHandle file)
+		{
+			LARGE_INTEGER size;
+			return GetFileSizeEx(reinterpret_cast<HANDLE>(file), &size) ? size.QuadPart : -1;
+		}
+
+		bool resizeFile(FileHandle file, uint64_t size)
+		{
+			FILE_END_OF_FILE_INFO info;
+			info.EndOfFile.QuadPart = static_cast<LONGLONG>(size);
+			return SetFileInformationByHandle(reinterpret_cast<HANDLE>(file), FileEndOfFileInfo, &info, sizeof(info)) != 0;
+		}
+
+		bool preallocateFile(FileHandle file, uint64_t size)
+		{
+			FILE_ALLOCATION_INFO info;
+			info.AllocationSize.QuadPart = static_cast<LONGLONG>(size);
+			return SetFileInformationByHandle(reinterpret_cast<HANDLE>(file), FileAllocationInfo, &info, sizeof(info)) != 0;
+		}
+
+		void * mapFile(FileHandle file, uint64_t size)
+		{
+			HANDLE mapping = CreateFileMappingA(reinterpret_cast<HANDLE>(file), nullptr, PAGE_READWRITE,
+				static_cast<DWORD>(size >> 32), static_cast<DWORD>(size), nullptr);
+			if (mapping == nullptr) {
+				return nullptr;
+			}
+			// the view keeps the mapping object alive
+			void * address = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, static_cast<SIZE_T>(size));
+			CloseHandle(mapping);
+			return address;
+		}
+
+		void unmapFile(void * address, uint64_t /*size*/)
+		{
+			UnmapViewOfFile(address);
+		}
+
+		bool writeStandardOutput(const char * data, size_t size)
+		{
+			HANDLE output = GetStdHandle(STD_OUTPUT_HANDLE);
+			while (size != 0) {
+				DWORD chunk = (size < MAXDWORD) ? static_cast<DWORD>(size) : MAXDWORD;
+				DWORD written = 0;
+				if (!WriteFile(output, data, chunk, &written, nullptr) || written == 0) {
+					return false;
+				}
+				data += written;
+				size -= written;
+			}
+			return true;
+		}
+
+		bool standardOutputIsTerminal()
+		{
+			DWORD mode;
+			return GetConsoleMode(GetStdHandle(STD_OUTPUT_HANDLE), &mode) != 0;
+		}
+
+		bool readStandardInput(char * data, size_t size, size_t & read)
+		{
+			DWORD chunk = (size < MAXDWORD) ? static_cast<DWORD>(size) : MAXDWORD;
+			DWORD transferred = 0;
+			read = 0;
+			if (!ReadFile(GetStdHandle(STD_INPUT_HANDLE), data, chunk, &transferred, nullptr)) {
+				// the writing end of a pipe is closed
+				return GetLastError() == ERROR_BROKEN_PIPE;
+			}
+			read = transferred;
+			return true;
+		}
+
+		bool flushMappedFile(void * address, uint64_t size)
+		{
+			return FlushViewOfFile(address, static_cast<SIZE_T>(size)) != 0;
+		}
+#else
+		void futexWait(atomic<uint32_t> & address, uint32_t expected)
+		{
+			syscall(SYS_futex, reinterpret_cast<uint32_t *>(&address), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+		}
+
+		void futexWakeOne(atomic<uint32_t> & address)
+		{
+			syscall(SYS_futex, reinterpret_cast<uint32_t *>(&address), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+		}
+
+		void futexWakeAll(atomic<uint32_t> & address)
+		{
+			syscall(SYS_futex, reinterpret_cast<uint32_t *>(&address), FUTEX_WAKE_PRIVATE, INT32_MAX, nullptr, nullptr, 0);
+		}
+
+		//! @brief Helper function. Read a number from sysfs topology file, defaultValue if it doesn't exist
+		static uint32_t readTopology(uint32_t cpu, const char * name, uint32_t defaultValue)
+		{
+			ifstream file("/sys/devices/system/cpu/cpu" + to_string(cpu) + "/topology/" + name);
+			uint32_t value;
+			return (file >> value) ? value : defaultValue;
+		}
+
+		vector<CpuInfo> availableCpus()
+		{
+			cpu_set_t set;
+			CPU_ZERO(&set);
+			if (sched_getaffinity(0, sizeof(set), &set) != 0) {
+				CPU_SET(0, &set);
+			}
+
+			vector<CpuInfo> res;
+			for (uint32_t cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+				if (CPU_ISSET(cpu, &set)) {
+					res.push_back(CpuInfo{ cpu, readTopology(cpu, "physical_package_id", 0), readTopology(cpu, "core_id", cpu) });
+				}
+			}
+			return res;
+		}
+
+		bool setThreadAffinity(const vector<uint32_t> & cpus)
+		{
+			cpu_set_t set;
+			CPU_ZERO(&set);
+			for (auto cpu : cpus) {
+				if (cpu < CPU_SETSIZE) {
+					CPU_SET(cpu, &set);
+				}
+			}
+			return CPU_COUNT(&set) != 0 && pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+		}
+
+		int32_t currentCpu()
+		{
+			return sched_getcpu();
+		}
+
+		FileHandle openFile(const string & fileName, FileAccess access)
+		{
+			if (access == FileAccess::ReadSequential) {
+				int file = open(fileName.c_str(), O_RDONLY | O_CLOEXEC);
+				if (file >= 0) {
+					// only a hint, the result doesn't matter
+					posix_fadvise(file, 0, 0, POSIX_FADV_SEQUENTIAL);
+				}
+				return file;
+			}
+			if (access == FileAccess::WriteSequential) {
+				return open(fileName.c_str(), O_WRONLY | O_CLOEXEC);
+			}
+			int flags = O_RDWR | O_CLOEXEC;
+			if (access == FileAccess::ReadWrite) {
+				flags |= O_CREAT;
+			}
+			else if (access == FileAccess::Create) {
+				flags |= O_CREAT | O_TRUNC;
+			}
+			return open(fileName.c_str(), flags, 0644);
+		}
+
+		void closeFile(FileHandle file)
+		{
+			close(static_cast<int>(file));
+		}
+
+		int64_t readFileAt(FileHandle file, uint64_t offset, void * data, size_t size)
+		{
+			ssize_t res;
+			do {
+				res = pread(static_cast<int>(file), data, size, static_cast<off_t>(offset));
+			} while (res < 0 && errno == EINTR);
+			return res;
+		}
+
+		int64_t writeFileAt(FileHandle file, uint64_t offset, const void * data, size_t size)
+		{
+			ssize_t res;
+			do {
+				res = pwrite(static_cast<int>(file), data, size, static_cast<off_t>(offset));
+			} while (res < 0 && errno == EINTR);
+			return res;
+		}
+
+		int64_t readFile(FileHandle file, void * data, size_t size)
+		{
+			ssize_t res;
+			do {
+				res = read(static_cast<int>(file), data, size);
+			} while (res < 0 && errno == EINTR);
+			return res;
+		}
+
+		int64_t writeFile(FileHandle file, const void * data, size_t size)
+		{
+			ssize_t res;
+			do {
+				res = write(static_cast<int>(file), data, size);
+			} while (res < 0 && errno == EINTR);
+			return res;
+		}
+
+		void ignoreBrokenPipe()
+		{
+			signal(SIGPIPE, SIG_IGN);
+		}
+
+		bool isSeekable(FileHandle file)
+		{
+			return lseek(static_cast<int>(file), 0, SEEK_CUR) >= 0;
+		}
+
+		bool isSameFile(const string & fileName1, const string & fileName2)
+		{
+			struct stat info1, info2;
+			return stat(fileName1.c_str(), &info1) == 0 && stat(fileName2.c_str(), &info2) == 0 &&
+				info1.st_dev == info2.st_dev && info1.st_ino == info2.st_ino;
+		}
+
+		int64_t fileSize(FileHandle file)
+		{
+			struct stat info;
+			return (fstat(static_cast<int>(file), &info) == 0) ? info.st_size : -1;
+		}
+
+		bool resizeFile(FileHandle file, uint64_t size)
+		{
+			return ftruncate(static_cast<int>(file), static_cast<off_t>(size)) == 0;
+		}
+
+		bool preallocateFile(FileHandle file, uint64_t size)
+		{
+			int res;
+			do {
+				res = fallocate(static_cast<int>(file), FALLOC_FL_KEEP_SIZE, 0, static_cast<off_t>(size));
+			} while (res != 0 && errno == EINTR);
+			return res == 0;
+		}
+
+		void * mapFile(FileHandle file, uint64_t size)
+		{
+			void * address = mmap(nullptr, static_cast<size_t>(size), PROT_READ | PROT_WRITE, 
+				MAP_SHARED | MAP_NORESERVE, static_cast<int>(file), 0);
+			return (address != MAP_FAILED) ? address : nullptr;
+		}
+
+		void unmapFile(void * address, uint64_t size)
+		{
+			munmap(address, static_cast<size_t>(size));
+		}
+
+		bool writeStandardOutput(const char * data, size_t size)
+		{
+			while (size != 0) {
+				ssize_t written = write(STDOUT_FILENO, data, size);
+				if (written < 0 && errno == EINTR) {
+					continue;
+				}
+				if (written <= 0) {
+					return false;
+				}
+				data += written;
+				size -= static_cast<size_t>(written);
+			}
+			return true;
+		}
+
+		bool standardOutputIsTerminal()
+		{
+			return isatty(STDOUT_FILENO) != 0;
+		}
+
+		bool readStandardInput(char * data, size_t size, size_t & read)
+		{
+			ssize_t transferred;
+			do {
+				transferred = ::read(STDIN_FILENO, data, size);
+			} while (transferred < 0 && errno == EINTR);
+			read = (transferred > 0) ? static_cast<size_t>(transferred) : 0;
+			return transferred >= 0;
+		}
+
+		bool flushMappedFile(void * address, uint64_t size)
+		{
+			return msync(address, static_cast<size_t>(size), MS_SYNC) == 0;
+		}
+#endif
+	}
+}
@@ -0,0 +1,267 @@
+//! @file	Platform.h
+//! @author	agent
+//! @date	10.2026
+//! @brief	Operating system specific helpers
+//!
+//! Thin wrappers over operating system primitives that are not available in
+//! the standard library. Each function has a Windows and a POSIX (Linux) implementation.
+#pragma once
+
+#include "stdafx.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace Evm {
+	namespace Platform {
+		constexpr size_t CACHE_LINE_SIZE = 64;	//!< Size of cache line on supported processors
+
+		//! @brief Spin-wait hint
+		//!
+		//! Tell the processor that the caller is busy waiting (pause on x86).
+		inline void cpuRelax() {
+#if defined(_MSC_VER)
+			_mm_pause();
+#elif defined(__x86_64__) || defined(__i386__)
+			__builtin_ia32_pause();
+#elif defined(__aarch64__)
+			asm volatile("yield");
+#endif
+		}
+
+		//! @brief Allocate aligned memory
+		//!
+		//! operator new doesn't respect extended alignment before C++17
+		//! @param size Size in bytes
+		//! @param alignment Alignment, power of 2
+		//! @return Pointer to the memory, nullptr on failure
+		void * alignedAlloc(size_t size, size_t alignment);
+
+		//! @brief Release memory allocated with alignedAlloc()
+		void alignedFree(void * memory);
+
+		//! @brief Deleter of objects created by makeAligned()
+		template <typename T>
+		struct AlignedDeleter {
+			void operator()(T * object) const {
+				object->~T();
+				alignedFree(object);
+			}
+		};
+
+		template <typename T>
+		using AlignedPtr = unique_ptr<T, AlignedDeleter<T>>;
+
+		//! @brief Create value initialized object that respects alignof(T)
+		//! @throw bad_alloc
+		template <typename T>
+		AlignedPtr<T> makeAligned() {
+			void * memory = alignedAlloc(sizeof(T), alignof(T));
+			if (memory == nullptr) {
+				throw bad_alloc{};
+			}
+			try {
+				return AlignedPtr<T>{ new (memory) T{} };
+			}
+			catch (...) {
+				alignedFree(memory);
+				throw;
+			}
+		}
+
+		//! @brief Logical processor description
+		struct CpuInfo {
+			uint32_t id;		//!< Logical processor number
+			uint32_t package;	//!< Physical package (socket)
+			uint32_t core;		//!< Physical core within the package, hyperthreads share it
+		};
+
+		//! @brief Get processors the process may run on
+		//!
+		//! @return Logical processors sorted by id
+		vector<CpuInfo> availableCpus();
+
+		//! @brief Restrict the calling thread to given processors
+		//!
+		//! @param cpus Logical processor numbers
+		//! @return True on success
+		bool setThreadAffinity(const vector<uint32_t> & cpus);
+
+		//! @brief Get processor the calling thread runs on
+		//!
+		//! @return Logical processor number, -1 if unknown
+		int32_t currentCpu();
+
+		//! @brief Park on an address
+		//!
+		//! Suspend the calling thread while the value under @ref address equals
+		//! @ref expected. The function may return spuriously.
+		//! @param address Address to wait on
+		//! @param expected Value that keeps the thread suspended
+		void futexWait(atomic<uint32_t> & address, uint32_t expected);
+
+		//! @brief Wake one thread parked on an address
+		//!
+		//! @param address Address the threads wait on
+		void futexWakeOne(atomic<uint32_t> & address);
+
+		//! @brief Wake all threads parked on an address
+		//!
+		//! @param address Address the threads wait on
+		void futexWakeAll(atomic<uint32_t> & address);
+
+		using FileHandle = intptr_t;				//!< Native file handle, HANDLE on Windows, descriptor on POSIX
+		constexpr FileHandle INVALID_FILE = -1;		//!< Handle of a file that is not open
+
+		//! @brief How a file is opened
+		enum class FileAccess {
+			ReadWrite,		//!< Read and write, create the file if it doesn't exist
+			ReadSequential,	//!< Read only, the system reads ahead for sequential access
+			Create,			//!< Read and write, create the file or truncate it
+			Update,			//!< Read and write an existing file
+			WriteSequential	//!< Write only an existing file, used for pipes
+		};
+
+		//! @brief Open a file
+		//!
+		//! @param fileName Name of the file
+		//! @param access How the file is opened
+		//! @return Handle of the file, INVALID_FILE on failure
+		FileHandle openFile(const string & fileName, FileAccess access);
+
+		//! @brief Close a file opened with openFile()
+		void closeFile(FileHandle file);
+
+		//! @brief Read from given offset
+		//!
+		//! The file position is neither used nor shared, so threads may read and
+		//! write the same file at the same time. The function may read fewer bytes
+		//! than requested.
+		//! @param file Handle of the file
+		//! @param offset Offset in the file
+		//! @param data Output buffer
+		//! @param size Size of the buffer
+		//! @return Number of bytes read, 0 at the end of the file, -1 on error
+		int64_t readFileAt(FileHandle file, uint64_t offset, void * data, size_t size);
+
+		//! @brief Write at given offset
+		//!
+		//! Like readFileAt(). Writing beyond the end of the file extends it, the gap
+		//! reads as zeros. The function may write fewer bytes than requested.
+		//! @param file Handle of the file
+		//! @param offset Offset in the file
+		//! @param data Data to write
+		//! @param size Number of bytes
+		//! @return Number of bytes written, -1 on error
+		int64_t writeFileAt(FileHandle file, uint64_t offset, const void * data, size_t size);
+
+		//! @brief Read from the current position of a file
+		//!
+		//! Used for pipes and other files without positions. The function may read fewer bytes
+		//! than requested.
+		//! @param file Handle of the file
+		//! @param data Output buffer
+		//! @param size Size of the buffer
+		//! @return Number of bytes read, 0 at the end of the file, -1 on error
+		int64_t readFile(FileHandle file, void * data, size_t size);
+
+		//! @brief Write at the current position of a file
+		//!
+		//! Like readFile(). The function may write fewer bytes than requested.
+		//! @param file Handle of the file
+		//! @param data Data to write
+		//! @param size Number of bytes
+		//! @return Number of bytes written, -1 on error
+		int64_t writeFile(FileHandle file, const void * data, size_t size);
+
+		//! @brief Make writes to a pipe without a reader fail instead of ending the process
+		//!
+		//! The writes fail with an error on Windows anyway.
+		void ignoreBrokenPipe();
+
+		//! @brief Check if a file supports positional access
+		//!
+		//! @param file Handle of the file
+		//! @return False for pipes, sockets and terminals
+		bool isSeekable(FileHandle file);
+
+		//! @brief Check if two names refer to the same file
+		//!
+		//! Files are compared by identity, not by name, so links and different
+		//! spellings of a path are recognized.
+		//! @param fileName1 Name of the first file
+		//! @param fileName2 Name of the second file
+		//! @return True if both files exist and are the same file
+		bool isSameFile(const string & fileName1, const string & fileName2);
+
+		//! @brief Get size of a file
+		//!
+		//! @param file Handle of the file
+		//! @return Size in bytes, -1 on error
+		int64_t fileSize(FileHandle file);
+
+		//! @brief Truncate or extend a file
+		//!
+		//! Extended part reads as zeros.
+		//! @param file Handle of the file
+		//! @param size New size in bytes
+		//! @return True on success
+		bool resizeFile(FileHandle file, uint64_t size);
+
+		//! @brief Allocate disk space of a file in advance
+		//!
+		//! The size of the file doesn't change, writes within the allocated space
+		//! don't update file system metadata. Not all file systems support it.
+		//! @param file Handle of the file
+		//! @param size Number of bytes from the beginning of the file
+		//! @return True on success, false if the file system doesn't support it or is full
+		bool preallocateFile(FileHandle file, uint64_t size);
+
+#ifdef _WIN32
+		constexpr uint64_t FILE_MAPPING_RESERVE = uint64_t{ 1 } << 26;	//!< Mapped part of a file, the file is extended to it
+#else
+		constexpr uint64_t FILE_MAPPING_RESERVE = uint64_t{ 1 } << 36;	//!< Mapped part of a file, address space only
+#endif
+
+		//! @brief Map a file to memory
+		//!
+		//! The mapping is shared and writable, it may be longer than the file.
+		//! On POSIX pages beyond the end of the file become valid when the file grows.
+		//! On Windows the file is extended to @ref size.
+		//! @param file Handle of the file
+		//! @param size Length of the mapping
+		//! @return Address of the mapping, nullptr on failure
+		void * mapFile(FileHandle file, uint64_t size);
+
+		//! @brief Write to standard output
+		//!
+		//! Unbuffered, bypasses iostreams. Short writes are continued.
+		//! @param data Data to write
+		//! @param size Number of bytes
+		//! @return True if all the bytes have been written
+		bool writeStandardOutput(const char * data, size_t size);
+
+		//! @brief Check if standard output is a terminal
+		bool standardOutputIsTerminal();
+
+		//! @brief Read from standard input
+		//!
+		//! Returns when some data is available, a terminal gives a line at a time
+		//! @param data Output buffer
+		//! @param size Size of the buffer
+		//! @param read Output, number of read bytes, 0 at the end of input
+		//! @return True on success
+		bool readStandardInput(char * data, size_t size, size_t & read);
+
+		//! @brief Remove mapping created with mapFile()
+		void unmapFile(void * address, uint64_t size);
+
+		//! @brief Write modified pages of a mapping to the file
+		//!
+		//! @param address Address of the mapping
+		//! @param size Number of bytes to write back
+		//! @return True on success
+		bool flushMappedFile(void * address, uint64_t size);
+	}
+}
@@ -0,0 +1,73 @@
+//! @file	PositionalFile.cpp
+//! @author	agent
+//! @date	10.2026
+//! @brief	PositionalFile class definition
+#include "stdafx.h"
+#include "PositionalFile.h"
+#include "RuntimeError.h"
+
+namespace Evm {
+	namespace Utils {
+		PositionalFile::PositionalFile(const string & fileName, Platform::FileAccess access, uint64_t expectedSize) :
+			_fileName{ fileName },
+			_file{ Platform::openFile(fileName, access) }
+		{
+			if (_file == Platform::INVALID_FILE) {
+				throw InputFileRuntimeError{ fileName, "Unable to open" };
+			}
+			if (expectedSize != 0) {
+				// best effort - without the allocation the file grows on write as usual
+				Platform::preallocateFile(_file, expectedSize);
+			}
+		}
+
+		PositionalFile::~PositionalFile()
+		{
+			Platform::closeFile(_file);
+		}
+
+		uint64_t PositionalFile::read(uint64_t offset, Byte * data, uint64_t size)
+		{
+			uint64_t done = 0;
+			while (done < size) {
+				uint64_t chunk = size - done;
+				if (chunk > MAX_TRANSFER) {
+					chunk = MAX_TRANSFER;
+				}
+				auto res = Platform::readFileAt(_file, offset + done, data + done, static_cast<size_t>(chunk));
+				if (res < 0) {
+					throw InputFileRuntimeError{ name(), "Unable to read. Offset: " + to_string(offset) +
+						" bytes: " + to_string(size) };
+				}
+				if (res == 0) {
+					break;
+				}
+				done += static_cast<uint64_t>(res);
+			}
+			return done;
+		}
+
+		bool PositionalFile::write(uint64_t offset, const Byte * data, uint64_t size)
+		{
+			uint64_t done = 0;
+			while (done < size) {
+				uint64_t chunk = size - done;
+				if (chunk > MAX_TRANSFER) {
+					chunk = MAX_TRANSFER;
+				}
+				auto res = Platform::writeFileAt(_file, offset + done, data + done, static_cast<size_t>(chunk));
+				if (res <= 0) {
+					return false;
+				}
+				done += static_cast<uint64_t>(res);
+			}
+			return true;
+		}
+
+		uint64_t PositionalFile::size()
+		{
+			auto res = Platform::fileSize(_file);
+			return (res < 0) ? 0 : static_cast<uint64_t>(res);
+		}
+	}
+}
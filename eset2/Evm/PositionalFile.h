@@ -0,0 +1,63 @@
+//! @file	PositionalFile.h
+//! @author	agent
+//! @date	10.2026
+//! @brief	PositionalFile class declaration
+//!
+//! PositionalFile wraps a native file handle and transfers data at explicit offsets
+//! (pread/pwrite), there is no shared file position and no lock. Threads that write
+//! disjoint ranges of the file proceed in parallel, the operating system orders
+//! overlapping writes.
+#pragma once
+
+#include "stdafx.h"
+#include "InputFile.h"
+#include "Platform.h"
+
+namespace Evm {
+	namespace Utils {
+		//! @brief File accessed with positional system calls
+		struct PositionalFile : IFile {
+			//! @brief Constructor
+			//!
+			//! Open the file. Failed preallocation is not an error, the space is allocated by writes.
+			//! @param fileName Name of the file
+			//! @param access How the file is opened
+			//! @param expectedSize Disk space allocated in advance if the file system supports it, 0 - none
+			//! @throw InputFileRuntimeError
+			PositionalFile(const string & fileName, Platform::FileAccess access, uint64_t expectedSize);
+
+			~PositionalFile() override;
+
+			uint64_t read(uint64_t offset, Byte * data, uint64_t size) override;
+
+			bool write(uint64_t offset, const Byte * data, uint64_t size) override;
+
+			//! @brief Nothing to do, data are written by system calls
+			bool flush() override {
+				return true;
+			}
+
+			uint64_t size() override;
+
+			const string & name() const override {
+				return _fileName;
+			}
+
+			bool nativeHandle(Platform::FileHandle & handle) const override {
+				handle = _file;
+				return true;
+			}
+
+			//! @brief Get native handle of the file
+			Platform::FileHandle handle() const {
+				return _file;
+			}
+
+		private:
+			static constexpr uint64_t MAX_TRANSFER = 1 << 30;	//!< The greatest block of a single system call
+
+			string _fileName;				//!< Name of the file
+			Platform::FileHandle _file;		//!< Native handle
+		};
+	}
+}
@@ -0,0 +1,156 @@
+//! @file	Program.cpp
+//! @author	agent
+//! @date	10.2026
+//! @brief	Program class definition
+#include "stdafx.h"
+#include "Program.h"
+#include "OperationFactory.h"
+#include "RangeAnalysis.h"
+
+namespace Evm {
+	using Operation::ControlFlow;
+
+	Program::Program(const Utils::BitBuffer & programMemory, uint64_t dataSize)
+	{
+		_decode(programMemory);
+		_verify();
+		_eliminateBoundsChecks(dataSize);
+	}
+
+	void Program::printStatistics(ostream & os) const
+	{
+		os << "\tprogram: instructions " << _instructions.size() << ", blocks " << _blocks <<
+			", verified " << _verifiedBlocks << ", undecodable addresses " << _undecodable << "\n";
+		os << "\tmemory arguments: " << _memoryAccesses << ", proven in range " << _uncheckedAccesses << "\n";
+	}
+
+	void Program::_decode(const Utils::BitBuffer & programMemory)
+	{
+		set<uint32_t> undecodable;
+		vector<uint32_t> pending{ 0 };
+		while (!pending.empty()) {
+			uint32_t address = pending.back();
+			pending.pop_back();
+			if (_instructions.count(address) != 0 || undecodable.count(address) != 0) {
+				continue;
+			}
+
+			uint32_t offset = address;
+			FaultRecord fault;
+			auto operation = Operation::tryMakeOperation(programMemory, offset, fault);
+			if (!operation) {
+				// reported at run time, if the thread ever gets there
+				undecodable.insert(address);
+				continue;
+			}
+
+			auto & instruction = _instructions[address];
+			instruction.address = address;
+			instruction.nextAddress = offset;
+			instruction.hasTarget = operation->target(instruction.targetAddress);
+			if (instruction.hasTarget) {
+				pending.push_back(instruction.targetAddress);
+			}
+			if (_fallsThrough(operation->controlFlow())) {
+				pending.push_back(offset);
+			}
+			instruction.operation = move(operation);
+		}
+		_undecodable = undecodable.size();
+	}
+
+	void Program::_verify()
+	{
+		// block leaders: the entry, targets and instructions after control transfers
+		set<uint32_t> leaders{ 0 };
+		for (const auto & entry : _instructions) {
+			const auto & instruction = entry.second;
+			if (instruction.hasTarget) {
+				leaders.insert(instruction.targetAddress);
+			}
+			if (instruction.operation->controlFlow() != ControlFlow::Next) {
+				leaders.insert(instruction.nextAddress);
+			}
+		}
+
+		auto it = _instructions.begin();
+		while (it != _instructions.end()) {
+			auto blockBegin = it;
+			bool verified = true;
+			bool blockEnds = false;
+			while (!blockEnds) {
+				const auto & instruction = it->second;
+				verified = verified && _successorsDecoded(instruction);
+				++it;
+				blockEnds = instruction.operation->controlFlow() != ControlFlow::Next ||
+					it == _instructions.end() || it->first != instruction.nextAddress ||
+					leaders.count(it->first) != 0;
+			}
+
+			_blocks++;
+			if (verified) {
+				_verifiedBlocks++;
+			}
+			for (auto b = blockBegin; b != it; ++b) {
+				b->second.verified = verified;
+				if (verified) {
+					_verified.emplace(b->first, &b->second);
+				}
+			}
+		}
+
+		// successor links lead only to verified code
+		for (auto & entry : _instructions) {
+			auto & instruction = entry.second;
+			if (!instruction.verified) {
+				continue;
+			}
+			instruction.next = find(instruction.nextAddress);
+			if (instruction.hasTarget) {
+				instruction.target = find(instruction.targetAddress);
+			}
+		}
+	}
+
+	void Program::_eliminateBoundsChecks(uint64_t dataSize)
+	{
+		RangeAnalysis ranges{ _instructions, dataSize };
+		for (auto & entry : _instructions) {
+			auto & instruction = entry.second;
+			if (!instruction.verified) {
+				continue;
+			}
+
+			const auto & args = instruction.operation->arguments();
+			for (size_t i = 0; i < args.size(); i++) {
+				uint8_t index;
+				uint64_t size;
+				if (!args[i]->memoryOperand(index, size)) {
+					continue;
+				}
+				_memoryAccesses++;
+				if (ranges.isInRange(instruction, *args[i])) {
+					instruction.operation->replaceArgument(i, Argument::getUncheckedMemoryArgument(index, size));
+					_uncheckedAccesses++;
+				}
+			}
+		}
+	}
+
+	bool Program::_successorsDecoded(const Instruction & instruction) const
+	{
+		if (instruction.hasTarget && _instructions.count(instruction.targetAddress) == 0) {
+			return false;
+		}
+		if (_fallsThrough(instruction.operation->controlFlow()) && 
+			_instructions.count(instruction.nextAddress) == 0) {
+			return false;
+		}
+		return true;
+	}
+
+	bool Program::_fallsThrough(ControlFlow flow)
+	{
+		return flow != ControlFlow::Jump && flow != ControlFlow::Return && flow != ControlFlow::Halt;
+	}
+}
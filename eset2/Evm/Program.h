@@ -0,0 +1,89 @@
+//! @file	Program.h
+//! @author	agent
+//! @date	10.2026
+//! @brief	Program class declaration
+//!
+//! Program is the verified and predecoded form of program memory. It is built once,
+//! after the evm file is validated. The verifier walks code reachable from address 0
+//! and from jump, call and createThread targets, decodes each instruction and splits
+//! the code into basic blocks. A block is verified when all its instructions decode and
+//! all their static successors decode as well.
+//! Verified instructions are executed without decoding and without program memory
+//! checks: the interpreter follows the successor links of an instruction and looks
+//! the address up only after ret or an unexpected program counter. Code that is not
+//! verified is decoded on each execution, as before, so errors are reported at the
+//! same place. Verification removes decoding only, verified and unverified code run the
+//! same operations with the same argument checks. Register indices and writes to
+//! constant arguments need no runtime check in any code: indices have 4 bits and
+//! destinations are decoded as register arguments.
+//! Memory arguments of verified instructions that @ref RangeAnalysis proves to be within
+//! data memory are replaced with arguments that skip the bounds check.
+#pragma once
+
+#include "stdafx.h"
+#include "Operation.h"
+#include "BitBuffer.h"
+
+namespace Evm {
+	//! @brief Predecoded instruction
+	struct Instruction {
+		Operation::OperationPtr operation;		//!< Decoded operation, shared by all threads
+		uint32_t address = 0;					//!< Address of the instruction
+		uint32_t nextAddress = 0;				//!< Address of the following instruction
+		uint32_t targetAddress = 0;				//!< Target of control transfer, valid if hasTarget
+		bool hasTarget = false;					//!< True for jump, jumpEqual, call and createThread
+		bool verified = false;					//!< True if the block of the instruction is verified
+		const Instruction * next = nullptr;		//!< Instruction at nextAddress, null if not verified
+		const Instruction * target = nullptr;	//!< Instruction at targetAddress, null if not verified
+	};
+
+	//! @brief Verified program
+	struct Program {
+		//! @brief Constructor
+		//!
+		//! Verify and decode program memory
+		//! @param programMemory Program memory
+		//! @param dataSize Size of data memory in bytes
+		Program(const Utils::BitBuffer & programMemory, uint64_t dataSize);
+
+		//! @brief Find verified instruction
+		//!
+		//! @param address Address of the instruction
+		//! @return The instruction, nullptr if the address is not in verified code
+		const Instruction * find(uint32_t address) const {
+			auto it = _verified.find(address);
+			return (it != _verified.end()) ? it->second : nullptr;
+		}
+
+		//! @brief Print verifier statistics
+		//! @param os Output stream
+		void printStatistics(ostream & os) const;
+
+		Program(const Program &) = delete;
+		Program & operator=(const Program &) = delete;
+
+	private:
+		map<uint32_t, Instruction> _instructions;					//!< Reachable decoded instructions
+		unordered_map<uint32_t, const Instruction *> _verified;		//!< Verified instructions by address
+		size_t _blocks = 0;					//!< Number of basic blocks
+		size_t _verifiedBlocks = 0;			//!< Number of verified basic blocks
+		size_t _undecodable = 0;			//!< Reachable addresses that can't be decoded
+		size_t _memoryAccesses = 0;			//!< Memory arguments in verified code
+		size_t _uncheckedAccesses = 0;		//!< Memory arguments proven in range
+
+		//! @brief Helper function. Decode reachable instructions
+		void _decode(const Utils::BitBuffer & programMemory);
+
+		//! @brief Helper function. Split instructions to blocks and verify them
+		void _verify();
+
+		//! @brief Helper function. Remove bounds checks of memory accesses proven in range
+		void _eliminateBoundsChecks(uint64_t dataSize);
+
+		//! @brief Helper function. True if all static successors of the instruction are decoded
+		bool _successorsDecoded(const Instruction & instruction) const;
+
+		//! @brief Helper function. True if the instruction after the operation may be executed next
+		static bool _fallsThrough(Operation::ControlFlow flow);
+	};
+}
@@ -0,0 +1,359 @@
+//! @file	RangeAnalysis.cpp
+//! @author	agent
+//! @date	10.2026
+//! @brief	RangeAnalysis class definition
+#include "stdafx.h"
+#include "RangeAnalysis.h"
+
+namespace Evm {
+	using Operation::ControlFlow;
+	using Operation::DataFlow;
+
+	RangeAnalysis::RangeAnalysis(const map<uint32_t, Instruction> & instructions, uint64_t dataSize) :
+		_instructions{ instructions },
+		_dataSize{ dataSize }
+	{
+		_collectThresholds();
+		_collectClobbered();
+		_solve();
+	}
+
+	bool RangeAnalysis::isInRange(const Instruction & instruction, const Argument::IArgument & argument) const
+	{
+		uint8_t index;
+		uint64_t size;
+		auto it = _entry.find(instruction.address);
+		if (!argument.memoryOperand(index, size) || it == _entry.end() || size > _dataSize) {
+			return false;
+		}
+
+		// arguments are read before the destination is written, the entry ranges hold
+		// for all memory arguments of the instruction
+		return it->second[index & ThreadCore::REGISTER_MASK].hi <= _dataSize - size;
+	}
+
+	void RangeAnalysis::_collectThresholds()
+	{
+		set<uint64_t> thresholds{ 0, _dataSize };
+		for (uint64_t size = 1; size <= 8 && size <= _dataSize; size *= 2) {
+			thresholds.insert(_dataSize - size);
+		}
+
+		// a counter compared with a constant stops one step before or after it
+		for (const auto & entry : _instructions) {
+			for (const auto & arg : entry.second.operation->arguments()) {
+				uint64_t value;
+				if (arg->constValue(value)) {
+					thresholds.insert(value);
+					thresholds.insert(value - 1);
+					thresholds.insert(value + 1);
+				}
+			}
+		}
+		_thresholds.assign(thresholds.begin(), thresholds.end());
+	}
+
+	void RangeAnalysis::_collectClobbered()
+	{
+		for (const auto & entry : _instructions) {
+			const auto & instruction = entry.second;
+			if (instruction.operation->controlFlow() == ControlFlow::Call) {
+				_clobbered[instruction.targetAddress] = 0;
+			}
+		}
+
+		// summaries of nested calls grow until nothing changes, masks only gain bits
+		bool changed = true;
+		while (changed) {
+			changed = false;
+			for (auto & entry : _clobbered) {
+				uint16_t mask = _clobberedBy(entry.first);
+				if (mask != entry.second) {
+					entry.second = mask;
+					changed = true;
+				}
+			}
+		}
+	}
+
+	uint16_t RangeAnalysis::_clobberedBy(uint32_t target) const
+	{
+		uint16_t mask = 0;
+		set<uint32_t> visited;
+		vector<uint32_t> pending{ target };
+		while (!pending.empty()) {
+			uint32_t address = pending.back();
+			pending.pop_back();
+			auto it = _instructions.find(address);
+			if (it == _instructions.end() || !visited.insert(address).second) {
+				continue;
+			}
+
+			const auto & instruction = it->second;
+			mask |= _written(instruction);
+			switch (instruction.operation->controlFlow()) {
+			case ControlFlow::Call: {
+				auto callee = _clobbered.find(instruction.targetAddress);
+				mask |= (callee != _clobbered.end()) ? callee->second : 0xffff;
+				pending.push_back(instruction.nextAddress);
+				break;
+			}
+			case ControlFlow::Branch:
+				pending.push_back(instruction.targetAddress);
+				pending.push_back(instruction.nextAddress);
+				break;
+			case ControlFlow::Jump:
+				pending.push_back(instruction.targetAddress);
+				break;
+			case ControlFlow::Next:
+			case ControlFlow::Spawn:
+				pending.push_back(instruction.nextAddress);
+				break;
+			case ControlFlow::Return:
+			case ControlFlow::Halt:
+			default:
+				break;
+			}
+		}
+		return mask;
+	}
+
+	uint16_t RangeAnalysis::_written(const Instruction & instruction)
+	{
+		const auto & operation = *instruction.operation;
+		size_t destination = operation.destination();
+		uint8_t index;
+		if (destination == Operation::IOperation::NO_DESTINATION ||
+			!operation.arguments()[destination]->registerOperand(index)) {
+			return 0;
+		}
+		return static_cast<uint16_t>(1 << (index & ThreadCore::REGISTER_MASK));
+	}
+
+	void RangeAnalysis::_solve()
+	{
+		Ranges unknown;
+
+		// the main thread starts with zeroed registers, other threads with copies
+		Ranges initial;
+		initial.fill(Interval::constant(0));
+		_join(0, initial);
+		for (const auto & entry : _instructions) {
+			const auto & instruction = entry.second;
+			if (instruction.operation->controlFlow() == ControlFlow::Spawn) {
+				_join(instruction.targetAddress, unknown);
+			}
+		}
+
+		while (!_pending.empty()) {
+			uint32_t address = _pending.back();
+			_pending.pop_back();
+			auto it = _instructions.find(address);
+			if (it == _instructions.end()) {
+				continue;
+			}
+
+			const auto & instruction = it->second;
+			const Ranges in = _entry[address];
+			switch (instruction.operation->controlFlow()) {
+			case ControlFlow::Next:
+			case ControlFlow::Spawn:
+				_join(instruction.nextAddress, _transfer(instruction, in));
+				break;
+			case ControlFlow::Jump:
+				_join(instruction.targetAddress, in);
+				break;
+			case ControlFlow::Branch: {
+				Ranges taken = in;
+				_narrow(instruction, true, taken);
+				_join(instruction.targetAddress, taken);
+				Ranges notTaken = in;
+				_narrow(instruction, false, notTaken);
+				_join(instruction.nextAddress, notTaken);
+				break;
+			}
+			case ControlFlow::Call: {
+				// registers the callee writes are unknown when it returns
+				_join(instruction.targetAddress, in);
+				Ranges returned = in;
+				uint16_t mask = _clobbered[instruction.targetAddress];
+				for (size_t i = 0; i < returned.size(); i++) {
+					if (mask & (1 << i)) {
+						returned[i] = Interval{};
+					}
+				}
+				_join(instruction.nextAddress, returned);
+				break;
+			}
+			case ControlFlow::Return:
+			case ControlFlow::Halt:
+			default:
+				break;
+			}
+		}
+	}
+
+	RangeAnalysis::Ranges RangeAnalysis::_transfer(const Instruction & instruction, const Ranges & in) const
+	{
+		Ranges out = in;
+		auto dataFlow = instruction.operation->dataFlow();
+		const auto & args = instruction.operation->arguments();
+		uint8_t index;
+
+		switch (dataFlow) {
+		case DataFlow::Copy:
+			if (args[1]->registerOperand(index)) {
+				out[index & ThreadCore::REGISTER_MASK] = _value(*args[0], in);
+			}
+			break;
+		case DataFlow::Add:
+		case DataFlow::Sub:
+		case DataFlow::Mul:
+		case DataFlow::Div:
+		case DataFlow::Mod:
+		case DataFlow::Compare:
+			if (args[2]->registerOperand(index)) {
+				out[index & ThreadCore::REGISTER_MASK] = _math(dataFlow, _value(*args[0], in), _value(*args[1], in));
+			}
+			break;
+		case DataFlow::Other:
+		default: {
+			// value is not modeled, e.g. consoleRead or read
+			uint16_t mask = _written(instruction);
+			for (size_t i = 0; i < out.size(); i++) {
+				if (mask & (1 << i)) {
+					out[i] = Interval{};
+				}
+			}
+			break;
+		}
+		}
+		return out;
+	}
+
+	void RangeAnalysis::_join(uint32_t address, const Ranges & ranges)
+	{
+		auto it = _entry.find(address);
+		if (it == _entry.end()) {
+			_entry.emplace(address, ranges);
+			_pending.push_back(address);
+			return;
+		}
+
+		bool changed = false;
+		auto & entry = it->second;
+		for (size_t i = 0; i < entry.size(); i++) {
+			Interval joined{ min(entry[i].lo, ranges[i].lo), max(entry[i].hi, ranges[i].hi) };
+			if (!(joined == entry[i])) {
+				entry[i] = _widen(entry[i], joined);
+				changed = true;
+			}
+		}
+		if (changed) {
+			_pending.push_back(address);
+		}
+	}
+
+	Interval RangeAnalysis::_widen(const Interval & old, const Interval & joined) const
+	{
+		// bounds move only to thresholds, each of them changes a finite number of times
+		Interval res = joined;
+		if (joined.lo < old.lo) {
+			auto it = upper_bound(_thresholds.begin(), _thresholds.end(), joined.lo);
+			res.lo = (it == _thresholds.begin()) ? 0 : *(it - 1);
+		}
+		if (joined.hi > old.hi) {
+			auto it = lower_bound(_thresholds.begin(), _thresholds.end(), joined.hi);
+			res.hi = (it == _thresholds.end()) ? numeric_limits<uint64_t>::max() : *it;
+		}
+		return res;
+	}
+
+	Interval RangeAnalysis::_math(DataFlow dataFlow, const Interval & a, const Interval & b)
+	{
+		const uint64_t maxValue = numeric_limits<uint64_t>::max();
+		const uint64_t maxSigned = static_cast<uint64_t>(numeric_limits<int64_t>::max());
+
+		// operations are signed with wrap-around, the result is exact only without overflow
+		switch (dataFlow) {
+		case DataFlow::Add:
+			if (a.hi <= maxValue - b.hi) {
+				return{ a.lo + b.lo, a.hi + b.hi };
+			}
+			break;
+		case DataFlow::Sub:
+			if (a.lo >= b.hi) {
+				return{ a.lo - b.hi, a.hi - b.lo };
+			}
+			break;
+		case DataFlow::Mul:
+			if (b.hi == 0 || a.hi <= maxValue / b.hi) {
+				return{ a.lo * b.lo, a.hi * b.hi };
+			}
+			break;
+		case DataFlow::Div:
+			if (a.hi <= maxSigned && b.hi <= maxSigned && b.lo > 0) {
+				return{ a.lo / b.hi, a.hi / b.lo };
+			}
+			break;
+		case DataFlow::Mod:
+			if (a.hi <= maxSigned && b.hi <= maxSigned && b.lo > 0) {
+				return{ 0, min(a.hi, b.hi - 1) };
+			}
+			break;
+		case DataFlow::Compare:
+		default:
+			break;
+		}
+		return Interval{};
+	}
+
+	Interval RangeAnalysis::_value(const Argument::IArgument & argument, const Ranges & ranges)
+	{
+		uint8_t index;
+		uint64_t value;
+		if (argument.constValue(value)) {
+			return Interval::constant(value);
+		}
+		if (argument.registerOperand(index)) {
+			return ranges[index & ThreadCore::REGISTER_MASK];
+		}
+		// memory contents are not tracked
+		return Interval{};
+	}
+
+	void RangeAnalysis::_narrow(const Instruction & instruction, bool equal, Ranges & ranges)
+	{
+		const auto & args = instruction.operation->arguments();
+		uint8_t index1, index2;
+		if (!args[1]->registerOperand(index1) || !args[2]->registerOperand(index2)) {
+			return;
+		}
+
+		auto & a = ranges[index1 & ThreadCore::REGISTER_MASK];
+		auto & b = ranges[index2 & ThreadCore::REGISTER_MASK];
+		if (equal) {
+			Interval both{ max(a.lo, b.lo), min(a.hi, b.hi) };
+			if (both.lo <= both.hi) {
+				a = both;
+				b = both;
+			}
+			return;
+		}
+
+		// a != b removes an end point equal to a constant
+		auto exclude = [](Interval & x, const Interval & c) {
+			if (!c.isConstant() || x.isConstant()) {
+				return;
+			}
+			if (x.hi == c.lo) {
+				x.hi--;
+			}
+			else if (x.lo == c.lo) {
+				x.lo++;
+			}
+		};
+		exclude(a, b);
+		exclude(b, a);
+	}
+}
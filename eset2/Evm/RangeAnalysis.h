@@ -0,0 +1,103 @@
+//! @file	RangeAnalysis.h
+//! @author	agent
+//! @date	10.2026
+//! @brief	RangeAnalysis class declaration
+//!
+//! RangeAnalysis computes, for each decoded instruction, an interval of unsigned values
+//! each register may hold when the instruction starts. It is a forward data flow analysis
+//! over the control flow graph of Program. loadConst, mov and math operations on registers
+//! are modeled, jumpEqual narrows the ranges on both edges, any other register write makes
+//! the register unknown. After a call returns, registers that the callee may write are
+//! unknown. Registers are unknown at thread entry points other than address 0.
+//! Joins are widened to constants found in the program (and to the data memory size),
+//! so loop counters that are compared with a constant keep a finite range and
+//! the analysis terminates.
+//! Memory contents are never tracked, so the result holds for any interleaving of threads.
+#pragma once
+
+#include "stdafx.h"
+#include "Program.h"
+
+namespace Evm {
+	//! @brief Closed interval of unsigned register values
+	struct Interval {
+		uint64_t lo = 0;								//!< Lower bound
+		uint64_t hi = numeric_limits<uint64_t>::max();	//!< Upper bound
+
+		//! @brief Interval of a single value
+		static Interval constant(uint64_t value) {
+			return{ value, value };
+		}
+
+		//! @brief Check if the interval has a single value
+		bool isConstant() const {
+			return lo == hi;
+		}
+
+		bool operator==(const Interval & other) const {
+			return lo == other.lo && hi == other.hi;
+		}
+	};
+
+	//! @brief Register range analysis
+	struct RangeAnalysis {
+		using Ranges = array<Interval, 16>;		//!< Ranges of all registers
+
+		//! @brief Constructor
+		//!
+		//! Run the analysis
+		//! @param instructions Decoded instructions of Program, by address
+		//! @param dataSize Size of data memory in bytes
+		RangeAnalysis(const map<uint32_t, Instruction> & instructions, uint64_t dataSize);
+
+		//! @brief Check if a memory argument is always in range
+		//!
+		//! @param instruction The instruction
+		//! @param argument Memory argument of the instruction
+		//! @return True if every access of the argument is proven to be within data memory
+		bool isInRange(const Instruction & instruction, const Argument::IArgument & argument) const;
+
+	private:
+		const map<uint32_t, Instruction> & _instructions;	//!< Analyzed instructions
+		uint64_t _dataSize;									//!< Data memory size
+		unordered_map<uint32_t, Ranges> _entry;				//!< Ranges at instruction start, by address
+		vector<uint64_t> _thresholds;						//!< Sorted widening thresholds
+		vector<uint32_t> _pending;							//!< Worklist, addresses with changed ranges
+		unordered_map<uint32_t, uint16_t> _clobbered;		//!< Call target -> mask of registers the callee may write
+
+		//! @brief Helper function. Collect widening thresholds
+		void _collectThresholds();
+
+		//! @brief Helper function. Compute registers written by each called function
+		void _collectClobbered();
+
+		//! @brief Helper function. Registers written by code reachable from a call target
+		//!
+		//! The walk stops at ret, nested calls add their current summaries
+		uint16_t _clobberedBy(uint32_t target) const;
+
+		//! @brief Helper function. Mask of registers the instruction may write
+		static uint16_t _written(const Instruction & instruction);
+
+		//! @brief Helper function. Propagate ranges to a fixed point
+		void _solve();
+
+		//! @brief Helper function. Ranges after the instruction on fall-through edge
+		Ranges _transfer(const Instruction & instruction, const Ranges & in) const;
+
+		//! @brief Helper function. Merge ranges into entry of an instruction
+		void _join(uint32_t address, const Ranges & ranges);
+
+		//! @brief Helper function. Widen an interval to thresholds
+		Interval _widen(const Interval & old, const Interval & joined) const;
+
+		//! @brief Helper function. Result of a math operation
+		static Interval _math(Operation::DataFlow dataFlow, const Interval & a, const Interval & b);
+
+		//! @brief Helper function. Range of an argument value
+		static Interval _value(const Argument::IArgument & argument, const Ranges & ranges);
+
+		//! @brief Helper function. Narrow ranges by arg1 == arg2 or arg1 != arg2
+		static void _narrow(const Instruction & instruction, bool equal, Ranges & ranges);
+	};
+}
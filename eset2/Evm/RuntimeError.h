@@ -35,6 +35,20 @@ namespace Evm {
 		{}
 	};
 
+	//! @brief Thread has exhausted its instruction budget
+	struct FuelExhaustedRuntimeError : RuntimeError {
+		FuelExhaustedRuntimeError(uint64_t fuel) :
+			RuntimeError{ "Instruction budget of " + to_string(fuel) + " exhausted" }
+		{}
+	};
+
+	//! @brief All evm threads are blocked
+	struct DeadlockRuntimeError : RuntimeError {
+		DeadlockRuntimeError() :
+			RuntimeError{ "Deadlock, all threads are blocked" }
+		{}
+	};
+
 	//! @brief Lock with given id doesn't exist
 	struct BadLockIDRuntimeError : RuntimeError {
 		BadLockIDRuntimeError(uint64_t id) :
@@ -42,6 +56,21 @@ namespace Evm {
 		{}
 	};
 
+	//! @brief File handle is not open
+	struct BadFileHandleRuntimeError : RuntimeError {
+		BadFileHandleRuntimeError(uint64_t handle) :
+			RuntimeError{ "File handle " + to_string(handle) + " is not open" }
+		{}
+	};
+
+	//! @brief Manifest has no entry with given index
+	struct BadManifestIndexRuntimeError : RuntimeError {
+		BadManifestIndexRuntimeError(uint64_t index, size_t entries) :
+			RuntimeError{ "Manifest entry " + to_string(index) + " doesn't exist, the manifest has " +
+				to_string(entries) + " entries" }
+		{}
+	};
+
 	//! @brief Evm file parsing error
 	struct EvmFileParseRuntimeError : RuntimeError {
 		EvmFileParseRuntimeError(const string & msg) :
@@ -66,6 +95,13 @@ namespace Evm {
 		{}
 	};
 
+	//! @brief Error while writing an output file
+	struct OutputFileRuntimeError : RuntimeError {
+		OutputFileRuntimeError(const string & filename, const string & msg) :
+			RuntimeError{ "Output file " + filename + " error: " + msg }
+		{}
+	};
+
 	//! @brief Bef register index
 	struct BadRegisterRuntimeError : RuntimeError {
 		BadRegisterRuntimeError(uint8_t regIndex) :
@@ -80,6 +116,13 @@ namespace Evm {
 		{}
 	};
 
+	//! @brief Call stack is deeper than allowed
+	struct StackOverflowRuntimeError : RuntimeError {
+		StackOverflowRuntimeError(size_t maxDepth) :
+			RuntimeError{ "Call stack overflow, maximum depth is " + to_string(maxDepth) }
+		{}
+	};
+
 	//! @brief Program memory exceeds 32 bit size
 	struct ProgramMemoryExceedBusWidthRuntimeError : RuntimeError {
 		ProgramMemoryExceedBusWidthRuntimeError() :
@@ -0,0 +1,121 @@
+//! @file	Scheduler.cpp
+//! @author	agent
+//! @date	10.2026
+//! @brief	RoundRobinScheduler class definition
+#include "stdafx.h"
+#include "Scheduler.h"
+#include "ThreadContext.h"
+#include "RuntimeError.h"
+#include "Application.h"
+
+namespace Evm {
+	RoundRobinScheduler::RoundRobinScheduler(uint64_t quantum) :
+		_quantum{ (quantum != 0) ? quantum : static_cast<uint64_t>(DEFAULT_QUANTUM) }
+	{}
+
+	void RoundRobinScheduler::add(ThreadContext * thread)
+	{
+		_runQueue.push_back(thread);
+	}
+
+	void RoundRobinScheduler::run(ThreadContext & mainThread)
+	{
+		// number of consecutive slices that haven't moved any thread forward
+		size_t idleSlices = 0;
+		auto application = mainThread.application();
+		auto asyncIo = application->asyncIo();
+
+		while (!mainThread.isFinished()) {
+			if (idleSlices >= _runQueue.size()) {
+				// no thread can run, wait for a transfer instead of the clock
+				auto waiting = find_if(_runQueue.begin(), _runQueue.end(), [](ThreadContext * t) { return t->ioPending(); });
+				if (waiting != _runQueue.end()) {
+					(*waiting)->waitForIo();
+					idleSlices = 0;
+					continue;
+				}
+
+				// every thread is blocked or sleeping, move the clock to the first wake-up
+				uint64_t wakeUp = numeric_limits<uint64_t>::max();
+				for (auto t : _runQueue) {
+					if (t->wakeUpTime() > _now) {
+						wakeUp = min(wakeUp, t->wakeUpTime());
+					}
+				}
+				if (wakeUp == numeric_limits<uint64_t>::max()) {
+					_abandonThreads();
+					throw DeadlockRuntimeError{};
+				}
+				_now = wakeUp;
+				idleSlices = 0;
+			}
+
+			ThreadContext * thread = _runQueue.front();
+			_runQueue.pop_front();
+			if (thread->wakeUpTime() > _now) {
+				_runQueue.push_back(thread);
+				idleSlices++;
+				continue;
+			}
+
+			uint64_t executed = 0;
+			SliceEnd end = thread->runSlice(_quantum, executed);
+			_slices++;
+			_instructions += executed;
+			_now += executed;
+
+			// a blocked thread executes the blocking instruction only, the instruction is repeated
+			bool progress = !(end == SliceEnd::Blocked && executed <= 1);
+			idleSlices = progress ? 0 : idleSlices + 1;
+			if (end == SliceEnd::Blocked) {
+				_blockedSlices++;
+			}
+			if (end != SliceEnd::Finished) {
+				_runQueue.push_back(thread);
+			}
+			else {
+				application->threadFinished(thread->id());
+			}
+			_submitIo(asyncIo);
+		}
+
+		_abandonThreads();
+	}
+
+	uint64_t RoundRobinScheduler::wakeUpTime(uint64_t ms) const
+	{
+		uint64_t maxTime = numeric_limits<uint64_t>::max();
+		if (ms > (maxTime - _now) / TICKS_PER_MS) {
+			return maxTime;
+		}
+		return _now + ms * TICKS_PER_MS;
+	}
+
+	void RoundRobinScheduler::printStatistics(ostream & os) const
+	{
+		os << "\tscheduler (round-robin): quantum " << _quantum << ", slices " << _slices <<
+			", blocked slices " << _blockedSlices << ", instructions " << _instructions <<
+			", virtual time [ms] " << _now / TICKS_PER_MS << "\n";
+	}
+
+	void RoundRobinScheduler::_submitIo(Utils::IAsyncIo * asyncIo)
+	{
+		_roundSlices++;
+		if (asyncIo != nullptr && _roundSlices >= _runQueue.size()) {
+			asyncIo->submitQueued();
+			_roundSlices = 0;
+		}
+	}
+
+	void RoundRobinScheduler::_abandonThreads()
+	{
+		while (!_runQueue.empty()) {
+			ThreadContext * thread = _runQueue.front();
+			_runQueue.pop_front();
+			uint64_t executed = 0;
+			thread->terminate();
+			thread->runSlice(0, executed);
+			thread->application()->threadFinished(thread->id());
+		}
+	}
+}
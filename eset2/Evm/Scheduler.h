@@ -0,0 +1,91 @@
+//! @file	Scheduler.h
+//! @author	agent
+//! @date	10.2026
+//! @brief	RoundRobinScheduler class declaration
+//!
+//! By default every evm thread runs on its own system thread. The round-robin
+//! scheduler runs all evm threads on the calling system thread instead. It switches
+//! threads every N instructions or when a thread would block, always in the same order,
+//! so an execution is repeatable and there is no system thread or lock contention
+//! overhead. Blocking instructions don't block in this mode: lock and joinThread
+//! yield and are executed again when the thread is resumed, sleep uses a virtual
+//! clock that advances with executed instructions. With asynchronous I/O read and write
+//! yield until their requests are done. Requests are submitted once per round (when
+//! each queued thread had a slice), the scheduler waits for I/O only when no thread can run.
+#pragma once
+
+#include "stdafx.h"
+
+namespace Evm {
+	struct ThreadContext;
+
+	namespace Utils {
+		struct IAsyncIo;
+	}
+
+	//! @brief Evm thread scheduler selector
+	enum class SchedulerPolicy {
+		Os,				//!< Each evm thread runs on a system thread
+		RoundRobin		//!< All evm threads run on the calling thread
+	};
+
+	//! @brief Reason why a time slice has ended
+	enum class SliceEnd {
+		Quantum,		//!< The thread has used its quantum
+		Blocked,		//!< The thread waits for a lock or for other thread
+		Sleeping,		//!< The thread sleeps
+		Finished		//!< The thread is done
+	};
+
+	//! @brief Deterministic single core round-robin scheduler
+	struct RoundRobinScheduler {
+		static constexpr uint64_t TICKS_PER_MS = 1000;	//!< Virtual clock: executed instructions per millisecond
+		static constexpr uint64_t DEFAULT_QUANTUM = 1000;	//!< Time slice used when quantum is 0
+
+		//! @brief Constructor
+		//!
+		//! @param quantum Number of instructions executed before the thread is switched, 0 - default
+		RoundRobinScheduler(uint64_t quantum);
+
+		//! @brief Add a thread to the end of the run queue
+		//!
+		//! @note Non-blocking function, called by ThreadContext::run()
+		//! @param thread The thread
+		void add(ThreadContext * thread);
+
+		//! @brief Run queued threads
+		//!
+		//! Execute threads on the calling system thread until the main thread is done.
+		//! Other threads are terminated then.
+		//! @note Blocking function
+		//! @param mainThread The main evm thread
+		//! @throw DeadlockRuntimeError
+		void run(ThreadContext & mainThread);
+
+		//! @brief Get wake-up time of sleep
+		//!
+		//! @param ms Sleep time in milliseconds
+		//! @return Virtual time when the sleep is over
+		uint64_t wakeUpTime(uint64_t ms) const;
+
+		//! @brief Print scheduler statistics
+		//! @param os Output stream
+		void printStatistics(ostream & os) const;
+
+	private:
+		const uint64_t _quantum;		//!< Instructions per time slice
+		deque<ThreadContext *> _runQueue;	//!< Threads in execution order
+		uint64_t _now = 0;				//!< Virtual clock [ticks]
+		uint64_t _slices = 0;			//!< Number of executed time slices
+		uint64_t _blockedSlices = 0;	//!< Slices that ended with a blocking instruction
+		uint64_t _instructions = 0;		//!< Number of executed instructions
+		size_t _roundSlices = 0;		//!< Slices since queued I/O requests were submitted
+
+		//! @brief Helper function. Submit queued I/O requests once per round
+		//! @param asyncIo Asynchronous I/O backend, may be nullptr
+		void _submitIo(Utils::IAsyncIo * asyncIo);
+
+		//! @brief Helper function. Terminate and finish all queued threads
+		void _abandonThreads();
+	};
+}
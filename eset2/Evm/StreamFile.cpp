@@ -0,0 +1,109 @@
+//! @file	StreamFile.cpp
+//! @author	agent
+//! @date	10.2026
+//! @brief	StreamFile class definition
+#include "stdafx.h"
+#include "StreamFile.h"
+#include "RuntimeError.h"
+
+namespace Evm {
+	namespace Utils {
+		StreamFile::StreamFile(unique_ptr<PositionalFile> file) :
+			_file{ move(file) }
+		{}
+
+		uint64_t StreamFile::read(uint64_t offset, Byte * data, uint64_t size)
+		{
+			lock_guard<mutex> lock(_guard);
+			if (offset < _windowOffset) {
+				throw InputFileRuntimeError{ name(), "Out of order read of a stream. Offset: " + to_string(offset) +
+					", the stream is at: " + to_string(_windowOffset) };
+			}
+
+			while (true) {
+				// the window slides to the offset, earlier data are never read again
+				uint64_t valid = _window.size() - _windowBegin;
+				uint64_t drop = min(offset - _windowOffset, valid);
+				_windowBegin += static_cast<size_t>(drop);
+				_windowOffset += drop;
+				valid -= drop;
+				if (_isEnd || (_windowOffset == offset && valid >= size)) {
+					break;
+				}
+				_fill((_windowOffset == offset) ? size : 0);
+			}
+			if (_windowOffset != offset) {
+				return 0;
+			}
+
+			uint64_t available = min(size, static_cast<uint64_t>(_window.size() - _windowBegin));
+			memcpy(data, _window.data() + _windowBegin, static_cast<size_t>(available));
+			return available;
+		}
+
+		bool StreamFile::write(uint64_t offset, const Byte * data, uint64_t size)
+		{
+			lock_guard<mutex> lock(_guard);
+			if (size == 0) {
+				return true;
+			}
+			if (offset < _writeEnd) {
+				throw InputFileRuntimeError{ name(), "Out of order write of a stream. Offset: " + to_string(offset) +
+					", the stream is at: " + to_string(_writeEnd) };
+			}
+
+			// a gap is written as zeros, like a gap of a regular file
+			if (offset > _writeEnd) {
+				const Bytes zeros(static_cast<size_t>(min(offset - _writeEnd, static_cast<uint64_t>(CHUNK_SIZE))));
+				while (_writeEnd < offset) {
+					uint64_t chunk = min(offset - _writeEnd, static_cast<uint64_t>(zeros.size()));
+					if (!_writeAll(zeros.data(), chunk)) {
+						return false;
+					}
+					_writeEnd += chunk;
+				}
+			}
+			if (!_writeAll(data, size)) {
+				return false;
+			}
+			_writeEnd += size;
+			return true;
+		}
+
+		uint64_t StreamFile::size()
+		{
+			lock_guard<mutex> lock(_guard);
+			return max(_windowOffset + (_window.size() - _windowBegin), _writeEnd);
+		}
+
+		void StreamFile::_fill(uint64_t size)
+		{
+			// move valid data to the beginning, the window doesn't grow with the stream
+			_window.erase(_window.begin(), _window.begin() + _windowBegin);
+			_windowBegin = 0;
+
+			size_t used = _window.size();
+			size_t chunk = static_cast<size_t>(max(static_cast<uint64_t>(CHUNK_SIZE), size - min(size, static_cast<uint64_t>(used))));
+			_window.resize(used + chunk);
+			auto res = Platform::readFile(_file->handle(), _window.data() + used, chunk);
+			_window.resize(used + static_cast<size_t>(max(res, static_cast<int64_t>(0))));
+			if (res < 0) {
+				throw InputFileRuntimeError{ name(), "Unable to read the stream" };
+			}
+			_isEnd = (res == 0);
+		}
+
+		bool StreamFile::_writeAll(const Byte * data, uint64_t size)
+		{
+			while (size != 0) {
+				auto res = Platform::writeFile(_file->handle(), data, static_cast<size_t>(min(size, static_cast<uint64_t>(CHUNK_SIZE))));
+				if (res <= 0) {
+					return false;
+				}
+				data += res;
+				size -= static_cast<uint64_t>(res);
+			}
+			return true;
+		}
+	}
+}
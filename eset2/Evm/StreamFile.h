@@ -0,0 +1,73 @@
+//! @file	StreamFile.h
+//! @author	agent
+//! @date	10.2026
+//! @brief	StreamFile class declaration
+//!
+//! StreamFile serves read and write instructions of a file without positions: a pipe,
+//! a socket or a terminal, so that evm can sit in a pipeline. Offsets of reads must not
+//! decrease. The stream is read ahead into a sliding window, a read is served from it and
+//! the window drops data before the offset of the read, so the same range may be read
+//! again, but the memory is bounded by the largest read. Data skipped by a read are
+//! discarded. Writes are appended, each write must start at or after the end of the
+//! previous one, a gap is filled with zeros. Out of order access is an error.
+//! A single mutex protects the file.
+#pragma once
+
+#include "stdafx.h"
+#include "InputFile.h"
+#include "PositionalFile.h"
+
+namespace Evm {
+	namespace Utils {
+		//! @brief Sequentially accessed file
+		struct StreamFile : IFile {
+			static constexpr uint64_t CHUNK_SIZE = 64 * 1024;	//!< Read-ahead of the stream
+
+			//! @brief Constructor
+			//!
+			//! @param file The file, only its handle is used
+			StreamFile(unique_ptr<PositionalFile> file);
+
+			//! @brief Read data block
+			//!
+			//! @throw InputFileRuntimeError if @ref offset is before the previous read
+			uint64_t read(uint64_t offset, Byte * data, uint64_t size) override;
+
+			//! @brief Append data block
+			//!
+			//! @throw InputFileRuntimeError if @ref offset is before the end of the previous write
+			bool write(uint64_t offset, const Byte * data, uint64_t size) override;
+
+			//! @brief Nothing to do, data are written by system calls
+			bool flush() override {
+				return true;
+			}
+
+			//! @brief Get the known part of the stream
+			//!
+			//! The end of read or written data, whichever is greater
+			uint64_t size() override;
+
+			const string & name() const override {
+				return _file->name();
+			}
+
+		private:
+			unique_ptr<PositionalFile> _file;	//!< The file
+			mutex _guard;				//!< Protects all members below
+			Bytes _window;				//!< Read part of the stream
+			size_t _windowBegin = 0;	//!< Index of the first valid byte of _window
+			uint64_t _windowOffset = 0;	//!< Stream offset of the first valid byte
+			bool _isEnd = false;		//!< True if the end of the stream has been read
+			uint64_t _writeEnd = 0;		//!< Stream offset of the next write
+
+			//! @brief Helper function. Read the stream, so that the window has at least @ref size bytes
+			//! @throw InputFileRuntimeError
+			void _fill(uint64_t size);
+
+			//! @brief Helper function. Write the whole block
+			//! @return True on success
+			bool _writeAll(const Byte * data, uint64_t size);
+		};
+	}
+}
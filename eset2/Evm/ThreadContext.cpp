@@ -10,119 +10,261 @@
 #include "RuntimeError.h"
 #include "Application.h"
 #include "Operation.h"
+#include "Platform.h"
+#include "Program.h"
 //#include "Trace.h"
 
 namespace Evm {
-	uint32_t ThreadContext::_currentThreadID = 0;
-
 	// Consdtuctor for the main thread
-	ThreadContext::ThreadContext(Application *application) :
-		_id{ _currentThreadID++ },
-		_thread{},
+	ThreadContext::ThreadContext(Application *application, uint64_t id) :
+		_core{ Platform::makeAligned<ThreadCore>() },
+		_id{ id },
 		_parent{ application },
-		_programCounter{ 0 },
 		_trace{ _traceFileName(), _parent->configuartion().trace }
 	{
-		// clear register list 
-		fill(begin(_registerList), end(_registerList), 0);
+		_core->callStack.maxDepth(_parent->configuartion().maxCallDepth);
 	}
 
 	// Copy constructor for children threads
-	ThreadContext::ThreadContext(const ThreadContext & caller, uint32_t address) :
-		_id{ _currentThreadID++ },
-		_thread{},
+	ThreadContext::ThreadContext(const ThreadContext & caller, uint64_t id, uint32_t address) :
+		_core{ Platform::makeAligned<ThreadCore>() },
+		_id{ id },
 		_parent{ caller._parent},
-		_programCounter{ address },
-		_registerList{ caller._registerList },
 		_trace{ _traceFileName(), _parent->configuartion().trace }
-	{}
+	{
+		_core->programCounter = address;
+		_core->instructionAddress = address;
+		_core->registers = caller._core->registers;
+		_core->callStack.maxDepth(_parent->configuartion().maxCallDepth);
+	}
+
+	void ThreadContext::reset(const ThreadContext & caller, uint64_t id, uint32_t address)
+	{
+		_id = id;
+		_parent = caller._parent;
+		_core->programCounter = address;
+		_core->instructionAddress = address;
+		_core->registers = caller._core->registers;
+		_core->callStack.clear();
+		_core->callStack.maxDepth(_parent->configuartion().maxCallDepth);
+		_core->nextInstruction = nullptr;
+		_core->isRunning = false;
+		_isFinished = true;
+		_io.state = Utils::IoRequest::IDLE;
+		_io.transferred = 0;
+		_io.failed = false;
+		_io.error = nullptr;
+		_lockWaitBegin = {};
+		_core->sliceEnd = SliceEnd::Quantum;
+		_wakeUpTime = 0;
+		_core->executedInstructions = 0;
+		_sliceStart = 0;
+		_trace.open(_traceFileName());
+	}
 
 	void ThreadContext::run()
 	{
-		_isRunning = true;
-
-		_thread = thread{ [&]() {
-			while (_isRunning) {
-				// Evm execution loop.
-				// In each iteration the next instruction is being decided and executed.
-				// Each instruction is converted to Operation class and executed.
-				try {
-					auto tmpProgramCounter = _programCounter;
-					auto operation = Operation::makeOperation(_parent->programMemory(), _programCounter);
-					if (_parent->configuartion().trace) {
-						_trace.log(tmpProgramCounter, operation->trace(*this));
-					}
-					
-					operation->execute(*this);
-				}
-				catch (RuntimeError & e) {
-					cerr << "Thread " << id() << " error at: " << programCounter() << ": " << e.what() << "\n";
-					return;
-				}
-			}
-		} };
+		_core->isRunning = true;
+		_isFinished = false;
+
+		auto scheduler = _parent->scheduler();
+		if (scheduler != nullptr) {
+			scheduler->add(this);
+			return;
+		}
+
+		_parent->workerPool().submit([this]() {
+			auto application = _parent;
+			auto id = _id;
+			_execute();
+			_finish();
+			// the context may be recycled from now on
+			application->threadFinished(id);
+		});
 	}
 
 	void ThreadContext::join()
 	{
-		if (_thread.joinable()) {
-			_thread.join();
+		unique_lock<mutex> lock(_stateGuard);
+		_finished.wait(lock, [this]() { return _isFinished; });
+	}
+
+	bool ThreadContext::isFinished()
+	{
+		lock_guard<mutex> lock(_stateGuard);
+		return _isFinished;
+	}
+
+	SliceEnd ThreadContext::runSlice(uint64_t maxInstructions, uint64_t & executed)
+	{
+		_core->sliceEnd = SliceEnd::Quantum;
+		executed = 0;
+		while (executed < maxInstructions && _core->isRunning.load(memory_order_relaxed)) {
+			_step();
+			executed++;
+			if (_core->sliceEnd != SliceEnd::Quantum) {
+				return _core->sliceEnd;
+			}
 		}
+
+		if (!_core->isRunning.load(memory_order_relaxed)) {
+			_finish();
+			return SliceEnd::Finished;
+		}
+		return SliceEnd::Quantum;
+	}
+
+	void ThreadContext::yield()
+	{
+		_core->programCounter = _core->instructionAddress;
+		_core->sliceEnd = SliceEnd::Blocked;
+	}
+
+	uint64_t ThreadContext::wakeUpTime() const
+	{
+		return _wakeUpTime;
 	}
 
 	void ThreadContext::sleep(uint64_t ms)
 	{
-		this_thread::sleep_for(chrono::milliseconds(ms));
+		auto scheduler = _parent->scheduler();
+		if (scheduler != nullptr) {
+			_wakeUpTime = scheduler->wakeUpTime(ms);
+			_core->sliceEnd = SliceEnd::Sleeping;
+			return;
+		}
+
+		unique_lock<mutex> lock(_stateGuard);
+		_wakeUp.wait_for(lock, chrono::milliseconds(ms), [this]() { return !_core->isRunning.load(); });
+	}
+
+	bool ThreadContext::readFile(uint64_t offset, Byte * data, uint64_t size, uint64_t & transferred)
+	{
+		return _transferFile(Utils::IoRequest::Type::Read, offset, data, size, transferred);
+	}
+
+	bool ThreadContext::writeFile(uint64_t offset, const Byte * data, uint64_t size, uint64_t & transferred)
+	{
+		// the request type tells the buffer is only read
+		return _transferFile(Utils::IoRequest::Type::Write, offset, const_cast<Byte *>(data), size, transferred);
+	}
+
+	bool ThreadContext::ioPending() const
+	{
+		return _io.state.load(memory_order_acquire) != Utils::IoRequest::IDLE;
+	}
+
+	void ThreadContext::waitForIo()
+	{
+		if (ioPending()) {
+			// the request may be queued only
+			_parent->asyncIo()->submitQueued();
+			_io.wait();
+		}
+	}
+
+	chrono::steady_clock::time_point & ThreadContext::lockWaitBegin()
+	{
+		return _lockWaitBegin;
+	}
+
+	void ThreadContext::useFile(uint64_t handle)
+	{
+		_file = (handle == Utils::FileTable::USER_FILES) ? nullptr : _parent->fileTable().get(handle);
+	}
+
+	Utils::IFile & ThreadContext::file(Utils::IoRequest::Type type)
+	{
+		if (_file) {
+			return *_file;
+		}
+		return (type == Utils::IoRequest::Type::Write) ? _parent->outputFile() : _parent->inputFile();
+	}
+
+	void ThreadContext::consoleWrite(uint64_t value)
+	{
+		auto & output = _parent->consoleOutput();
+		if (_outputBuffer == nullptr) {
+			_outputBuffer = output.acquire();
+		}
+		output.write(*_outputBuffer, value);
 	}
 
 	void ThreadContext::reg(uint8_t index, uint64_t value)
 	{
-		if (index >= _registerList.size()) {
+		if (index >= _core->registers.size()) {
 			throw BadRegisterRuntimeError{ index };
 		}
 
-		_registerList.at(index) = value;
+		_core->registers.at(index) = value;
 	}
 
 	uint64_t ThreadContext::reg(uint8_t index) const
 	{
-		if (index >= _registerList.size()) {
+		if (index >= _core->registers.size()) {
 			throw BadRegisterRuntimeError{ index };
 		}
 
-		return _registerList.at(index);
+		return _core->registers.at(index);
 	}
 
-	uint32_t ThreadContext::id() const
+	uint64_t ThreadContext::id() const
 	{
 		return _id;
 	}
 
 	uint32_t ThreadContext::programCounter() const
 	{
-		return _programCounter;
+		return _core->programCounter;
+	}
+
+	uint32_t ThreadContext::instructionAddress() const
+	{
+		return _core->instructionAddress;
 	}
 
 	void ThreadContext::programCounter(uint32_t newValue)
 	{
-		_programCounter = newValue;
+		_core->programCounter = newValue;
+		_core->nextInstruction = nullptr;
 	}
 
 	void ThreadContext::push(uint32_t value)
 	{
-		_callStack.push(value);
+		if (!_core->callStack.push(value)) {
+			throw StackOverflowRuntimeError{ _core->callStack.maxDepth() };
+		}
 	}
 
 	uint32_t ThreadContext::pop()
 	{
-		try {
-			uint32_t value = _callStack.top();
-			_callStack.pop();
-			return value;
-		}
-		catch (...) {
+		uint32_t value;
+		if (!_core->callStack.pop(value)) {
 			throw StackRuntimeError{};
 		}
+		return value;
+	}
+
+	Fault ThreadContext::raise(Fault fault, uint64_t address, uint64_t size, uint64_t limit)
+	{
+		_fault.fault = fault;
+		_fault.address = address;
+		_fault.size = size;
+		_fault.limit = limit;
+		_fault.message.clear();
+		return fault;
+	}
+
+	Fault ThreadContext::raise(const RuntimeError & error)
+	{
+		raise(Fault::RuntimeError);
+		_fault.message = error.what();
+		return Fault::RuntimeError;
+	}
+
+	const FaultRecord & ThreadContext::fault() const
+	{
+		return _fault;
 	}
 
 	Application * ThreadContext::application()
@@ -132,7 +274,204 @@ namespace Evm {
 
 	void ThreadContext::terminate()
 	{
-		_isRunning = false;
+		_core->isRunning = false;
+
+		// wake up the sleep, notify under the lock so the wake-up can't be missed
+		lock_guard<mutex> lock(_stateGuard);
+		_wakeUp.notify_all();
+	}
+
+	void ThreadContext::_execute()
+	{
+		int32_t startCpu = Platform::currentCpu();
+
+		// Evm execution loop.
+		// In each iteration the next instruction is being decided and executed.
+		while (_core->isRunning.load(memory_order_relaxed)) {
+			_step();
+		}
+
+		_parent->cpuPlacement().recordThread(startCpu, Platform::currentCpu());
+	}
+
+	void ThreadContext::_step()
+	{
+		auto & core = *_core;
+		const Instruction * instruction = core.nextInstruction;
+		if (instruction == nullptr) {
+			instruction = _parent->program().find(core.programCounter);
+			if (instruction == nullptr) {
+				_stepUnverified();
+				return;
+			}
+		}
+
+		// verified code - no decoding, no program memory checks. The operation checks its arguments as usual.
+		core.instructionAddress = instruction->address;
+		core.programCounter = instruction->nextAddress;
+		if (_parent->configuartion().trace && !_traceOperation(*instruction->operation)) {
+			core.nextInstruction = nullptr;
+			_reportFault();
+			return;
+		}
+
+		if (instruction->operation->run(*this) != Fault::None) {
+			core.nextInstruction = nullptr;
+			_reportFault();
+			return;
+		}
+		core.executedInstructions++;
+
+		if (core.programCounter == instruction->nextAddress) {
+			core.nextInstruction = instruction->next;
+			return;
+		}
+
+		// the links are null for code that isn't verified, ret and yield() are looked up
+		core.nextInstruction = (instruction->hasTarget && core.programCounter == instruction->targetAddress) ?
+			instruction->target : nullptr;
+		if (_blockEnd() != Fault::None) {
+			_reportFault();
+		}
+	}
+
+	void ThreadContext::_stepUnverified()
+	{
+		// Each instruction is converted to Operation class and executed.
+		// Errors are returned as fault codes, the message is built only when it is reported.
+		_core->instructionAddress = _core->programCounter;
+		auto operation = Operation::tryMakeOperation(_parent->programMemory(), _core->programCounter, _fault);
+		if (!operation) {
+			_reportFault();
+			return;
+		}
+
+		uint32_t nextAddress = _core->programCounter;
+		if (_parent->configuartion().trace && !_traceOperation(*operation)) {
+			_reportFault();
+			return;
+		}
+
+		if (operation->run(*this) != Fault::None) {
+			_reportFault();
+			return;
+		}
+		_core->executedInstructions++;
+
+		// taken jump, call or ret ends a basic block. Budgets are checked only here,
+		// no loop can avoid the check.
+		if (_core->programCounter != nextAddress && _blockEnd() != Fault::None) {
+			_reportFault();
+		}
+	}
+
+	bool ThreadContext::_traceOperation(const Operation::IOperation & operation)
+	{
+		// printed values are read with the throwing API, tracing is not the fast path
+		try {
+			_trace.log(_core->instructionAddress, operation.trace(*this));
+		}
+		catch (RuntimeError & e) {
+			raise(e);
+			return false;
+		}
+		return true;
+	}
+
+	void ThreadContext::_reportFault()
+	{
+		cerr << "Thread " << id() << " error at: " << programCounter() << ": " << faultMessage(_fault) << "\n";
+		_core->isRunning = false;
+	}
+
+	Fault ThreadContext::_blockEnd()
+	{
+		const auto & config = _parent->configuartion();
+		if (config.fuel != 0 && _core->executedInstructions >= config.fuel) {
+			if (config.fuelAction == FuelAction::Program) {
+				_parent->terminate();
+			}
+			return raise(Fault::FuelExhausted, 0, 0, config.fuel);
+		}
+
+		// the round-robin scheduler counts its slices itself
+		if (config.quantum != 0 && _core->executedInstructions - _sliceStart >= config.quantum &&
+			_parent->scheduler() == nullptr) {
+			_sliceStart = _core->executedInstructions;
+			this_thread::yield();
+		}
+		return Fault::None;
+	}
+
+	bool ThreadContext::_transferFile(Utils::IoRequest::Type type, uint64_t offset, Byte * data, uint64_t size,
+		uint64_t & transferred)
+	{
+		auto & file = this->file(type);
+		auto asyncIo = _parent->asyncIo();
+		if (asyncIo == nullptr) {
+			_io.file = &file;
+			_io.type = type;
+			_io.offset = offset;
+			_io.data = data;
+			_io.size = size;
+			_io.execute();
+			transferred = _io.transferred;
+			_rethrowIoError();
+			return true;
+		}
+
+		// a yielded instruction is executed again, it finds its request submitted
+		if (_io.state.load(memory_order_acquire) == Utils::IoRequest::IDLE) {
+			_io.file = &file;
+			_io.type = type;
+			_io.offset = offset;
+			_io.data = data;
+			_io.size = size;
+			_io.transferred = 0;
+			_io.failed = false;
+			_io.state.store(Utils::IoRequest::PENDING, memory_order_relaxed);
+			asyncIo->queue(_io);
+		}
+		if (_io.state.load(memory_order_acquire) != Utils::IoRequest::DONE) {
+			yield();
+			return false;
+		}
+
+		transferred = _io.transferred;
+		_io.state.store(Utils::IoRequest::IDLE, memory_order_relaxed);
+		_rethrowIoError();
+		return true;
+	}
+
+	void ThreadContext::_rethrowIoError()
+	{
+		if (_io.error) {
+			auto error = _io.error;
+			_io.error = nullptr;
+			rethrow_exception(error);
+		}
+		// a failed write transfers less than requested, the write instruction reports it
+		if (_io.failed && _io.type == Utils::IoRequest::Type::Read) {
+			throw InputFileRuntimeError{ _io.file->name(), "Unable to read. Offset: " + to_string(_io.offset) +
+				" bytes: " + to_string(_io.size) };
+		}
+	}
+
+	void ThreadContext::_finish()
+	{
+		// a terminated thread may have a request in flight, it refers to the context
+		waitForIo();
+		if (_outputBuffer != nullptr) {
+			_parent->consoleOutput().release(_outputBuffer);
+			_outputBuffer = nullptr;
+		}
+		_file = nullptr;
+
+		// notify under the lock - a joiner may recycle the context as soon as
+		// it sees _isFinished, the executing thread must not touch it afterwards
+		lock_guard<mutex> lock(_stateGuard);
+		_isFinished = true;
+		_finished.notify_all();
 	}
 
 	string ThreadContext::_traceFileName() const
@@ -12,6 +12,13 @@
 //#include "Operation.h"
 #include "RuntimeError.h"
 #include "Trace.h"
+#include "Scheduler.h"
+#include "Platform.h"
+#include "CallStack.h"
+#include "Fault.h"
+#include "AsyncIo.h"
+#include "ConsoleOutput.h"
+#include "FileTable.h"
 
 //! @namespace Eva
 //!
@@ -19,6 +26,40 @@
 namespace Evm {
 
 	struct Application;
+	struct Instruction;
+
+	namespace Operation {
+		struct IOperation;
+	}
+
+	//! @brief Hot interpreter state of evm thread
+	//!
+	//! State touched by every instruction. It is allocated separately from the rest of
+	//! ThreadContext and aligned to a cache line, so the state of one thread never shares
+	//! a cache line with other threads or with cold state (trace stream, synchronization).
+	struct alignas(Platform::CACHE_LINE_SIZE) ThreadCore {
+		static constexpr uint8_t REGISTER_MASK = 0x0f;	//!< Register index has 4 bits in bytecode
+
+		array<uint64_t, 16> registers{};	//!< Register list
+		uint32_t programCounter = 0;		//!< Program Counter
+		uint32_t instructionAddress = 0;	//!< Address of current instruction
+		uint64_t executedInstructions = 0;	//!< Number of executed instructions
+		atomic<bool> isRunning{ false };	//!< The thread execution loop is running until
+											//!< this variable is true
+		SliceEnd sliceEnd = SliceEnd::Quantum;	//!< Set by yield() and sleep() to end a time slice
+		const Instruction * nextInstruction = nullptr;	//!< Verified instruction at programCounter,
+														//!< null if it has to be looked up
+		Utils::CallStack callStack;			//!< Call stack
+
+		//! @brief Register access without bounds check
+		//!
+		//! For indices decoded from bytecode. The index is masked, so no check is needed.
+		//! @param index Index of the register
+		//! @return Reference to the register
+		uint64_t & reg(uint8_t index) {
+			return registers[index & REGISTER_MASK];
+		}
+	};
 
 	//! @brief Evm thread class
 	//!
@@ -29,25 +70,38 @@ namespace Evm {
 		//!
 		//! Usually used to create the first thread.
 		//! @parent appliation Pointer to a parent
-		ThreadContext(Application *application);
+		//! @param id Unique thread ID
+		ThreadContext(Application *application, uint64_t id);
 
 		//! @brief Copy constructor
 		//!
 		//! It is used to create new evm threads that are based on
 		//! caller thread
 		//! @param caller Reference to caller thread
+		//! @param id Unique thread ID
 		//! @param address Program counter value for the new thread
-		ThreadContext(const ThreadContext & caller, uint32_t address);
+		ThreadContext(const ThreadContext & caller, uint64_t id, uint32_t address);
+
+		//! @brief Reinitialize finished thread
+		//!
+		//! Used to recycle a finished and disposed context as a new evm thread that is
+		//! based on caller thread. The result is the same as of the copy constructor.
+		//! @param caller Reference to caller thread
+		//! @param id Unique thread ID
+		//! @param address Program counter value for the new thread
+		void reset(const ThreadContext & caller, uint64_t id, uint32_t address);
 
 		//! @brief Get Thread ID
 		//!
 		//! The function returns the thread ID
 		//! @return Thread IS
-		uint32_t id() const;
+		uint64_t id() const;
 
 		//! @brief Run the thread
 		//!
-		//! The function launches the current thread. Essentially it spowns a system thread.
+		//! The function launches the current thread. Essentially it hands the thread to an idle
+		//! system thread of the application worker pool, the system thread returns to the pool
+		//! when the evm thread is done.
 		//! A task operates in loop where the evm instructions are captured, decoded and executed.
 		//! The exectution lasts until terminate() function is called or and error occurs.
 		//! @note Non-blocking function
@@ -56,16 +110,114 @@ namespace Evm {
 		//! @brief Join the thread
 		//!
 		//! The sunction suspends until the thread is in exetution.
+		//! Many threads may join the same thread. A thread that has never been run
+		//! is considered finished.
 		//! @note Blocking function
 		void join();
 
+		//! @brief Check if the thread is finished
+		//!
+		//! @return True if the execution loop is done or hasn't started
+		bool isFinished();
+
+		//! @brief Run a time slice
+		//!
+		//! Used by RoundRobinScheduler. Execute at most maxInstructions instructions
+		//! on the calling system thread. The slice ends early when the thread blocks,
+		//! sleeps or is done.
+		//! @param maxInstructions Quantum of the slice
+		//! @param executed Output, number of executed instructions
+		//! @return Reason why the slice has ended
+		SliceEnd runSlice(uint64_t maxInstructions, uint64_t & executed);
+
+		//! @brief Yield the rest of the time slice
+		//!
+		//! Used by blocking instructions under RoundRobinScheduler instead of blocking.
+		//! The program counter is moved back, so the instruction is executed again
+		//! when the thread is resumed.
+		void yield();
+
+		//! @brief Get wake-up time
+		//!
+		//! Used by RoundRobinScheduler. Virtual time when the thread may be resumed
+		//! @return Virtual time in scheduler ticks
+		uint64_t wakeUpTime() const;
+
 		//! @brief Sleep
 		//!
-		//! Suspend execution of the thread for given time
+		//! Suspend execution of the thread for given time. The sleep ends early
+		//! when the thread is terminated. Under RoundRobinScheduler the thread yields
+		//! and the time is virtual.
 		//! @param ms Time in milliseconds
 		//! @note Blocking function
 		void sleep(uint64_t ms);
 
+		//! @brief Select the file of readFile() and writeFile()
+		//!
+		//! @param handle Handle of a file in the application file table,
+		//!		Utils::FileTable::USER_FILES for the input and output files
+		//! @throw BadFileHandleRuntimeError
+		void useFile(uint64_t handle);
+
+		//! @brief Get the file of readFile() or writeFile()
+		//!
+		//! @param type Direction of the transfer
+		//! @return The file selected with useFile(), the input or output file if none is selected
+		//! @throw InputFileRuntimeError
+		Utils::IFile & file(Utils::IoRequest::Type type);
+
+		//! @brief Read the input file, or the file selected with useFile()
+		//!
+		//! With asynchronous I/O (RoundRobinScheduler only) only this evm thread waits for
+		//! the transfer: the thread yields and the instruction is executed again when
+		//! the request is done.
+		//! @param offset Offset in the file
+		//! @param data Output buffer
+		//! @param size Number of bytes to read
+		//! @param transferred Output, number of read bytes
+		//! @return True if the transfer is done, false if the thread has yielded
+		//! @throw InputFileRuntimeError
+		bool readFile(uint64_t offset, Byte * data, uint64_t size, uint64_t & transferred);
+
+		//! @brief Write the output file, the input file if there is no output file,
+		//! or the file selected with useFile()
+		//!
+		//! Like readFile()
+		//! @param offset Offset in the file
+		//! @param data Data to write
+		//! @param size Number of bytes to write
+		//! @param transferred Output, number of written bytes, less than @ref size on error
+		//! @return True if the transfer is done, false if the thread has yielded
+		//! @throw InputFileRuntimeError
+		bool writeFile(uint64_t offset, const Byte * data, uint64_t size, uint64_t & transferred);
+
+		//! @brief Check if an asynchronous transfer is in progress
+		//!
+		//! Used by RoundRobinScheduler, a thread that waits for I/O is not deadlocked.
+		//! @return True if the transfer is pending or done, but its instruction hasn't been resumed
+		bool ioPending() const;
+
+		//! @brief Wait until the asynchronous transfer is done
+		//!
+		//! Queued requests are submitted first
+		//! @note Blocking function
+		void waitForIo();
+
+		//! @brief Get the start of a retried evm lock acquisition
+		//!
+		//! Under RoundRobinScheduler a thread yields instead of blocking on a taken lock and
+		//! the lock instruction is executed again. Its first failed attempt sets the time,
+		//! the acquisition clears it.
+		//! @return Time of the first failed attempt, the epoch if the thread doesn't wait
+		chrono::steady_clock::time_point & lockWaitBegin();
+
+		//! @brief Write a value to the console
+		//!
+		//! The line is formatted into the console output buffer of this thread,
+		//! it is written to the standard output when the buffer is flushed
+		//! @param value The value
+		void consoleWrite(uint64_t value);
+
 		// @brief Set value to a register
 		//!
 		//! Set a value to a register with given index
@@ -87,6 +239,13 @@ namespace Evm {
 		//! @retrun Current value in program counter
 		uint32_t programCounter() const;
 
+		//! @brief Get address of current instruction
+		//!
+		//! Program counter points to the next instruction while an operation
+		//! is executed. This is the address of the instruction being executed.
+		//! @return Address of current instruction
+		uint32_t instructionAddress() const;
+
 		//! @brief Set value to program counter
 		//!
 		//! It is good for jump and call instructions
@@ -97,14 +256,45 @@ namespace Evm {
 		//!
 		//! Save return address on a stack
 		//! @param value Value to push to the stack
+		//! @throw StackOverflowRuntimeError
 		void push(uint32_t value);
 
 		//! @breif Pop value from a stack
 		//!
 		//! Load return address form a stack
 		//! @return Value from the top of the stuck
+		//! @throw StackRuntimeError
 		uint32_t pop();
 
+		//! @brief Record a fault
+		//!
+		//! Used by operations and arguments on the fast path instead of throwing
+		//! @param fault Fault code
+		//! @param address Faulting address
+		//! @param size Size of faulting access
+		//! @param limit Violated limit
+		//! @return The fault code, so the caller may return it
+		Fault raise(Fault fault, uint64_t address = 0, uint64_t size = 0, uint64_t limit = 0);
+
+		//! @brief Record a RuntimeError as a fault
+		//!
+		//! Used where the slow path throws
+		//! @param error The error
+		//! @return Fault::RuntimeError
+		Fault raise(const RuntimeError & error);
+
+		//! @brief Get the last recorded fault
+		const FaultRecord & fault() const;
+
+		//! @brief Get hot interpreter state
+		//!
+		//! Fast path for operations and arguments, e.g. register access without
+		//! bounds checks
+		//! @return Reference to the hot state
+		ThreadCore & core() {
+			return *_core;
+		}
+
 		//! @brief Get pointer to application
 		//!
 		//! Return pointer to a parent - application
@@ -115,22 +305,65 @@ namespace Evm {
 
 		//! @biref Terminate
 		//!
-		//! Terminate a thread
+		//! Terminate a thread. The thread leaves its execution loop after the current
+		//! instruction, sleeping thread is woken up. May be called by any thread.
 		void terminate();
 	private:
-		uint32_t _id;		//!< Thread unique ID
-		thread _thread;		//!< System thread
+		Platform::AlignedPtr<ThreadCore> _core;	//!< Hot state, first member - the pointer is used most
+		uint64_t _id;		//!< Thread unique ID
 		Application * _parent;		//!< Pointer to parent - application
-		uint32_t _programCounter;	//!< Program Counter
-		array<uint64_t, 16> _registerList;	//!< Register list
-		stack<uint32_t> _callStack;		//!< Call stack
-		bool _isRunning = false;		//!< The thread execution loop is running until
-										//!< this variable is true
+		mutex _stateGuard;				//!< Protects _isFinished, used by sleep
+		condition_variable _finished;	//!< Signaled when the thread is finished
+		condition_variable _wakeUp;		//!< Signaled when the thread is terminated
+		bool _isFinished = true;		//!< True if the execution loop is done or hasn't started
+		uint64_t _wakeUpTime = 0;		//!< Virtual wake-up time under RoundRobinScheduler
+		uint64_t _sliceStart = 0;		//!< Value of ThreadCore::executedInstructions when the thread last yielded
+		FaultRecord _fault;				//!< The last fault, read when the error is reported
+		Utils::IoRequest _io;			//!< Asynchronous transfer of a user file
+		chrono::steady_clock::time_point _lockWaitBegin;	//!< First failed attempt of a retried lock, see lockWaitBegin()
+		Utils::FileTable::SharedFilePtr _file;	//!< File selected with useFile(), null - the input and output files
+		Utils::ConsoleOutput::Buffer * _outputBuffer = nullptr;	//!< Console output buffer, taken on the first write
 		Utils::Trace _trace;
 
 		string _traceFileName() const;
 
-		static uint32_t _currentThreadID;
+		//! @brief Helper function. Execution loop, runs on a worker pool thread
+		void _execute();
+
+		//! @brief Helper function. Execute one instruction
+		//!
+		//! Verified instructions are taken from Program, the rest is decoded.
+		//! Errors are reported and terminate the thread
+		void _step();
+
+		//! @brief Helper function. Decode and execute one instruction of unverified code
+		void _stepUnverified();
+
+		//! @brief Helper function. Write an operation to the trace
+		//! @return False if a fault has been recorded
+		bool _traceOperation(const Operation::IOperation & operation);
+
+		//! @brief Helper function. Report the recorded fault and stop the thread
+		void _reportFault();
+
+		//! @brief Helper function. Bookkeeping at the end of a basic block
+		//!
+		//! Called after a control transfer. Checks the instruction budget and yields
+		//! the system thread when the quantum is used.
+		//! @return Fault::FuelExhausted when the budget is used
+		Fault _blockEnd();
+
+		//! @brief Helper function. Common part of readFile() and writeFile()
+		bool _transferFile(Utils::IoRequest::Type type, uint64_t offset, Byte * data, uint64_t size,
+			uint64_t & transferred);
+
+		//! @brief Helper function. Throw the error of the finished transfer, if there is one
+		void _rethrowIoError();
+
+		//! @brief Helper function. Mark the thread finished and wake up joiners
+		//!
+		//! The console output buffer is returned, its lines are flushed later
+		void _finish();
 	};
 
 	//!< Thread exception type
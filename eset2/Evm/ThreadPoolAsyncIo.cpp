@@ -0,0 +1,82 @@
+//! @file	ThreadPoolAsyncIo.cpp
+//! @author	agent
+//! @date	10.2026
+//! @brief	ThreadPoolAsyncIo class definition
+#include "stdafx.h"
+#include "ThreadPoolAsyncIo.h"
+
+namespace Evm {
+	namespace Utils {
+		ThreadPoolAsyncIo::ThreadPoolAsyncIo()
+		{
+			for (size_t i = 0; i < WORKER_COUNT; i++) {
+				_workers.emplace_back([this]() { _work(); });
+			}
+		}
+
+		ThreadPoolAsyncIo::~ThreadPoolAsyncIo()
+		{
+			{
+				lock_guard<mutex> lock(_guard);
+				_isStopping = true;
+			}
+			_requestAvailable.notify_all();
+			for (auto & worker : _workers) {
+				worker.join();
+			}
+		}
+
+		void ThreadPoolAsyncIo::submit(IoRequest & request)
+		{
+			{
+				lock_guard<mutex> lock(_guard);
+				_requests.push_back(&request);
+				_statistics.requests++;
+			}
+			_requestAvailable.notify_one();
+		}
+
+		void ThreadPoolAsyncIo::queue(IoRequest & request)
+		{
+			lock_guard<mutex> lock(_guard);
+			_requests.push_back(&request);
+			_statistics.requests++;
+		}
+
+		void ThreadPoolAsyncIo::submitQueued()
+		{
+			_requestAvailable.notify_all();
+		}
+
+		AsyncIoStatistics ThreadPoolAsyncIo::statistics()
+		{
+			lock_guard<mutex> lock(_guard);
+			return _statistics;
+		}
+
+		void ThreadPoolAsyncIo::_work()
+		{
+			vector<IoRequest *> batch;
+			unique_lock<mutex> lock(_guard);
+			while (true) {
+				_requestAvailable.wait(lock, [this]() { return _isStopping || !_requests.empty(); });
+				if (_requests.empty()) {
+					return;
+				}
+
+				// a share of the queue, the other workers take the rest
+				size_t count = (_requests.size() + WORKER_COUNT - 1) / WORKER_COUNT;
+				batch.assign(_requests.begin(), _requests.begin() + count);
+				_requests.erase(_requests.begin(), _requests.begin() + count);
+				_statistics.batches++;
+
+				lock.unlock();
+				for (auto request : batch) {
+					request->execute();
+					request->complete();
+				}
+				lock.lock();
+			}
+		}
+	}
+}
@@ -0,0 +1,55 @@
+//! @file	ThreadPoolAsyncIo.h
+//! @author	agent
+//! @date	10.2026
+//! @brief	ThreadPoolAsyncIo class declaration
+//!
+//! ThreadPoolAsyncIo is the portable asynchronous I/O backend. Submitted requests are
+//! queued, a few system threads take them in batches and execute them with blocking
+//! calls of their files.
+#pragma once
+
+#include "stdafx.h"
+#include "AsyncIo.h"
+
+namespace Evm {
+	namespace Utils {
+		//! @brief Asynchronous I/O on a pool of system threads
+		struct ThreadPoolAsyncIo : IAsyncIo {
+			static constexpr size_t WORKER_COUNT = 4;	//!< Number of system threads
+
+			//! @brief Constructor
+			//!
+			//! Spawn the workers
+			ThreadPoolAsyncIo();
+
+			//! @brief Destructor
+			//!
+			//! Execute queued requests and stop the workers
+			//! @note Blocking function
+			~ThreadPoolAsyncIo() override;
+
+			void submit(IoRequest & request) override;
+
+			void queue(IoRequest & request) override;
+
+			void submitQueued() override;
+
+			const char * name() const override {
+				return "threads";
+			}
+
+			AsyncIoStatistics statistics() override;
+
+		private:
+			mutex _guard;						//!< Protects all members below
+			condition_variable _requestAvailable;	//!< Signaled when a request is queued or the pool stops
+			deque<IoRequest *> _requests;		//!< Requests waiting for a worker
+			bool _isStopping = false;			//!< True when the backend is being destroyed
+			AsyncIoStatistics _statistics;		//!< Statistics
+			vector<thread> _workers;			//!< System threads
+
+			//! @brief Helper function. Worker loop
+			void _work();
+		};
+	}
+}
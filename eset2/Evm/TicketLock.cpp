@@ -0,0 +1,92 @@
+//! @file	TicketLock.cpp
+//! @author	agent
+//! @date	10.2026
+//! @brief	TicketLock class definition
+#include "stdafx.h"
+#include "TicketLock.h"
+#include "Platform.h"
+
+namespace Evm {
+	namespace Utils {
+		bool TicketLock::lock()
+		{
+			if (_isCancelled.load(memory_order_relaxed)) {
+				return false;
+			}
+
+			uint32_t ticket = _nextTicket.fetch_add(1, memory_order_relaxed);
+			if (_nowServing.load(memory_order_acquire) == ticket) {
+				_acquired();
+				return true;
+			}
+
+			auto waitBegin = _waitBegin();
+			for (uint32_t i = 0; i < SPIN_COUNT; i++) {
+				Platform::cpuRelax();
+				if (_nowServing.load(memory_order_acquire) == ticket) {
+					_acquiredContended(waitBegin, 0);
+					return true;
+				}
+				if (_isCancelled.load(memory_order_relaxed)) {
+					return false;
+				}
+			}
+
+			// Park until our ticket is served. Every unlock wakes all parked threads,
+			// only the owner of the next ticket proceeds.
+			uint64_t parks = 0;
+			uint32_t serving;
+			while ((serving = _nowServing.load(memory_order_acquire)) != ticket) {
+				_parked.fetch_add(1);
+				if (_isCancelled.load()) {
+					_parked.fetch_sub(1);
+					return false;
+				}
+				// re-check after announcing the waiter, unlock() could miss it otherwise
+				serving = _nowServing.load();
+				if (serving != ticket) {
+					Platform::futexWait(_nowServing, serving);
+					parks++;
+				}
+				_parked.fetch_sub(1);
+			}
+			_acquiredContended(waitBegin, parks);
+			return true;
+		}
+
+		bool TicketLock::_tryAcquire()
+		{
+			if (_isCancelled.load(memory_order_relaxed)) {
+				return false;
+			}
+
+			// take a ticket only if it would be served immediately
+			uint32_t serving = _nowServing.load(memory_order_acquire);
+			uint32_t expected = serving;
+			return _nextTicket.compare_exchange_strong(expected, serving + 1, memory_order_acquire);
+		}
+
+		void TicketLock::unlock()
+		{
+			// a free lock serves the next ticket, moving past it would make the lock
+			// wait for a ticket that is never taken again
+			uint32_t serving = _nowServing.load();
+			do {
+				if (serving == _nextTicket.load()) {
+					return;
+				}
+			} while (!_nowServing.compare_exchange_weak(serving, serving + 1));
+			if (_parked.load() != 0) {
+				Platform::futexWakeAll(_nowServing);
+			}
+		}
+
+		void TicketLock::cancel()
+		{
+			// change the futex word, so waiters that haven't seen the flag yet don't park
+			_isCancelled.store(true);
+			_nowServing.fetch_add(1);
+			Platform::futexWakeAll(_nowServing);
+		}
+	}
+}
@@ -0,0 +1,40 @@
+//! @file	TicketLock.h
+//! @author	agent
+//! @date	10.2026
+//! @brief	TicketLock class declaration
+//!
+//! TicketLock is a FIFO fair lock for evm lock/unlock instructions. Threads obtain
+//! the lock in the order they asked for it, so no thread starves under heavy contention
+//! (e.g. philosophers.evm). The price is lower throughput - the lock is always handed
+//! over to the next waiter, even if it has been parked.
+#pragma once
+
+#include "stdafx.h"
+#include "Lock.h"
+
+namespace Evm {
+	namespace Utils {
+		//! @brief FIFO fair ticket lock
+		//!
+		//! A thread takes a ticket and waits until the lock serves its number.
+		//! Waiters spin for a while and then park on the futex word of the
+		//! "now serving" counter. The lock may be released by any thread.
+		struct TicketLock : ILock {
+			static constexpr uint32_t SPIN_COUNT = 100;		//!< Spin iterations before parking
+
+			using ILock::ILock;
+			virtual bool lock() override;
+			virtual void unlock() override;
+			virtual void cancel() override;
+
+		protected:
+			virtual bool _tryAcquire() override;
+
+		private:
+			atomic<uint32_t> _nextTicket{ 0 };		//!< Next ticket to take
+			atomic<uint32_t> _nowServing{ 0 };		//!< Ticket that owns the lock, futex word
+			atomic<uint32_t> _parked{ 0 };			//!< Number of parked waiters
+			atomic<bool> _isCancelled{ false };		//!< True if the lock has been cancelled
+		};
+	}
+}
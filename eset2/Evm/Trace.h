@@ -18,10 +18,10 @@ namespace Evm {
 			//!
 			//! @param filename File name of log file
 			//! @param true if trace is enabled
-			Trace(const string & filename, bool enableTrace) {
-				if (enableTrace) {
-					_outputFile.open(filename, ios::trunc);
-				}
+			Trace(const string & filename, bool enableTrace) :
+				_isEnabled{ enableTrace }
+			{
+				open(filename);
 			}
 
 			//! @brief Destructor
@@ -29,6 +29,17 @@ namespace Evm {
 				if (_outputFile.is_open()) _outputFile.close();
 			}
 
+			//! @brief Switch to other log file
+			//!
+			//! Close current log file and open new one. Does nothing if the trace is disabled.
+			//! @param filename File name of log file
+			void open(const string & filename) {
+				if (_isEnabled) {
+					if (_outputFile.is_open()) _outputFile.close();
+					_outputFile.open(filename, ios::trunc);
+				}
+			}
+
 			//! @brief Log message
 			//!
 			//! Log message @ref msg to file. Timestamp is added at beginning
@@ -57,6 +68,7 @@ namespace Evm {
 				log(oss.str());
 			}
 		private:
+			bool _isEnabled;			//!< True if trace is enabled
 			ofstream _outputFile;		//!< Log file
 		};
 	}
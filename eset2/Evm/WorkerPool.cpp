@@ -0,0 +1,97 @@
+//! @file	WorkerPool.cpp
+//! @author	agent
+//! @date	10.2026
+//! @brief	WorkerPool class definition
+#include "stdafx.h"
+#include "WorkerPool.h"
+
+namespace Evm {
+	namespace Utils {
+		WorkerPool::WorkerPool(size_t initialWorkers, size_t maxIdleWorkers, function<void()> workerInit) :
+			_maxIdleWorkers{ max(initialWorkers, maxIdleWorkers) },
+			_workerInit{ move(workerInit) }
+		{
+			lock_guard<mutex> guard(_guard);
+			for (size_t i = 0; i < initialWorkers; i++) {
+				_spawnWorker();
+				// count it as idle now, so first tasks don't spawn more workers
+				_idleWorkers++;
+			}
+		}
+
+		WorkerPool::~WorkerPool()
+		{
+			unique_lock<mutex> guard(_guard);
+			_isStopping = true;
+			_taskAvailable.notify_all();
+			_workerExited.wait(guard, [this]() { return _liveWorkers == 0; });
+		}
+
+		void WorkerPool::submit(Task task)
+		{
+			lock_guard<mutex> guard(_guard);
+			_statistics.tasks++;
+			if (_idleWorkers > _tasks.size()) {
+				_statistics.reusedWorkers++;
+			}
+			else {
+				_spawnWorker();
+				_idleWorkers++;
+			}
+			_tasks.push_back(PendingTask{ move(task), Clock::now() });
+			_taskAvailable.notify_one();
+		}
+
+		WorkerPoolStatistics WorkerPool::statistics()
+		{
+			lock_guard<mutex> guard(_guard);
+			return _statistics;
+		}
+
+		void WorkerPool::_spawnWorker()
+		{
+			_liveWorkers++;
+			_statistics.spawnedWorkers++;
+			// workers are detached, the destructor waits for them with _liveWorkers
+			thread{ [this]() { _work(); } }.detach();
+		}
+
+		void WorkerPool::_work()
+		{
+			if (_workerInit) {
+				_workerInit();
+			}
+
+			unique_lock<mutex> guard(_guard);
+			while (true) {
+				// the worker is counted as idle here
+				_taskAvailable.wait(guard, [this]() { return _isStopping || !_tasks.empty(); });
+				if (_tasks.empty()) {
+					// stopped while idle
+					_idleWorkers--;
+					break;
+				}
+
+				PendingTask pending = move(_tasks.front());
+				_tasks.pop_front();
+				_idleWorkers--;
+				auto latency = chrono::duration_cast<chrono::nanoseconds>(Clock::now() - pending.submitTime).count();
+				_statistics.startLatency.add(static_cast<uint64_t>(latency));
+
+				guard.unlock();
+				pending.task();
+				pending.task = nullptr;
+				guard.lock();
+
+				if (_isStopping || _idleWorkers >= _maxIdleWorkers) {
+					// enough parked workers, release the system thread
+					break;
+				}
+				_idleWorkers++;
+			}
+
+			_liveWorkers--;
+			_workerExited.notify_all();
+		}
+	}
+}
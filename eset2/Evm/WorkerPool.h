@@ -0,0 +1,87 @@
+//! @file	WorkerPool.h
+//! @author	agent
+//! @date	10.2026
+//! @brief	WorkerPool class declaration
+//!
+//! WorkerPool keeps system threads that execute evm threads. Spawning a system thread
+//! for every createThread instruction is expensive, it dominates fork-join programs
+//! like multithreaded_file_write.evm. The pool pre-spawns a number of parked workers,
+//! hands tasks to idle workers and grows when all workers are busy. A worker that
+//! finishes its task parks again, unless there are already enough idle workers.
+#pragma once
+
+#include "stdafx.h"
+#include "Lock.h"
+
+namespace Evm {
+	namespace Utils {
+		//! @brief Worker pool statistics
+		struct WorkerPoolStatistics {
+			uint64_t spawnedWorkers = 0;	//!< Number of system threads spawned by the pool
+			uint64_t tasks = 0;				//!< Number of submitted tasks
+			uint64_t reusedWorkers = 0;		//!< Tasks that were handed to an idle worker
+			WaitHistogram startLatency;		//!< Time from submit() to start of the task [ns]
+		};
+
+		//! @brief Pool of system threads
+		//!
+		//! The pool never blocks submit() - when there is no idle worker, new one is spawned.
+		//! Evm threads may block for a long time (lock, joinThread), a fixed size pool
+		//! could deadlock.
+		struct WorkerPool {
+			using Task = function<void()>;
+
+			//! @brief Constructor
+			//!
+			//! @param initialWorkers Number of workers spawned in advance
+			//! @param maxIdleWorkers Number of idle workers kept parked, workers above the limit exit
+			//! @param workerInit Function called by each worker when it starts, may be empty
+			WorkerPool(size_t initialWorkers, size_t maxIdleWorkers, function<void()> workerInit = nullptr);
+
+			//! @brief Destructor
+			//!
+			//! Stop idle workers and wait until all workers exit
+			//! @note Blocking function, waits for running tasks
+			~WorkerPool();
+
+			//! @brief Run a task
+			//!
+			//! Hand the task to an idle worker, spawn new worker if there is none.
+			//! @note Non-blocking function
+			//! @param task Task to run
+			void submit(Task task);
+
+			//! @brief Get pool statistics
+			WorkerPoolStatistics statistics();
+
+			WorkerPool(const WorkerPool &) = delete;
+			WorkerPool & operator=(const WorkerPool &) = delete;
+
+		private:
+			using Clock = chrono::steady_clock;
+
+			//! Submitted task
+			struct PendingTask {
+				Task task;					//!< The task
+				Clock::time_point submitTime;	//!< Time of submit()
+			};
+
+			const size_t _maxIdleWorkers;	//!< Limit of parked workers
+			const function<void()> _workerInit;	//!< Called by each worker when it starts
+			mutex _guard;					//!< Protects all members below
+			condition_variable _taskAvailable;	//!< Signaled when a task is queued or the pool stops
+			condition_variable _workerExited;	//!< Signaled when a worker exits
+			deque<PendingTask> _tasks;		//!< Tasks waiting for a worker
+			size_t _idleWorkers = 0;		//!< Number of workers waiting for a task
+			size_t _liveWorkers = 0;		//!< Number of existing workers
+			bool _isStopping = false;		//!< True when the pool is being destroyed
+			WorkerPoolStatistics _statistics;	//!< Statistics
+
+			//! @brief Helper function. Spawn new worker, call it with _guard locked
+			void _spawnWorker();
+
+			//! @brief Helper function. Worker loop
+			void _work();
+		};
+	}
+}
@@ -24,6 +24,10 @@ int main(int argc, char** argv)
 		Evm::Application app{ cliConfig };
 		app.run();
 		app.wait();
+		if (cliConfig.statistics) {
+			app.printStatistics(cerr);
+		}
+		app.printLockProfile(cerr);
 	}
 	catch (Evm::RuntimeError & e) {
 		cout << e.what();
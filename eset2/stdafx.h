@@ -16,10 +16,14 @@
 #include <iterator>
 #include <string>
 #include <memory>
+#include <exception>
 #include <fstream>
 #include <utility>
+#include <tuple>
 #include <array>
+#include <bitset>
 #include <stack>
+#include <deque>
 #include <functional>
 #include <iomanip>
 #include <ios>
@@ -27,8 +31,14 @@
 #include <thread>
 #include <chrono>
 #include <mutex>
+#include <condition_variable>
 #include <map>
+#include <set>
+#include <unordered_map>
+#include <atomic>
 #include <limits>
+#include <cmath>
+#include <cstring>
 using namespace std;
 
 using Byte = uint8_t;
@@ -41,6 +41,11 @@ class Assembler(object):
         "hlt":             Opcode("10110", ""),        # 10110 hlt
         "sleep":           Opcode("10111", "R"),       # 10111 sleep time
 
+        "size":            Opcode("010000", "RR"),     # 010000 size r-handle, r-size
+        "open":            Opcode("010110", "RR"),     # 010110 open r-manifestindex, r-handle
+        "close":           Opcode("010111", "R"),      # 010111 close r-handle
+        "useFile":         Opcode("01111", "R"),       # 01111 useFile r-handle
+
         "call":            Opcode("1100", "L"),        # 1100 call code-offset
         "ret":             Opcode("1101", ""),         # 1101 ret
 